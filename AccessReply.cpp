@@ -0,0 +1,199 @@
+/*
+ *  radiusplugin -- An OpenVPN plugin for do radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+
+#include "AccessReply.h"
+#include "RadiusClass/RadiusPacket.h"
+
+/** The constructor creates an empty reply.*/
+AccessReply::AccessReply(void)
+{
+	this->acctinteriminterval=0;
+}
+
+/** The method removes all attributes.*/
+void AccessReply::clear(void)
+{
+	this->routes.clear();
+	this->routes6.clear();
+	this->framedip.clear();
+	this->framedip6.clear();
+	this->acctinteriminterval=0;
+	this->vsas.clear();
+	this->replymessage.clear();
+}
+
+/** The method fills the reply in one pass over the attributes of a
+ * received packet. Only the first Framed-IP-Address, Framed-IPv6-Address and
+ * Acct-Interim-Interval are taken. The vendor specific attributes are split
+ * into their sub attributes, an attribute which isn't in the format of 
+ * RFC 2865 is skipped.
+ * @param packet The packet with the response.
+ * @return The number of skipped vendor specific attributes.
+ */
+int AccessReply::parse(RadiusPacket *packet)
+{
+	RadiusAttributeView	view;
+	AccessReplyVsa		vsa;
+	bool				interval=false, framedip=false, framedip6=false;
+	uint32_t			vendor;
+	int					pos, skipped=0;
+	
+	this->clear();
+	while (packet->nextAttribute(&view))
+	{
+		switch (view.type)
+		{
+			case ATTRIB_Framed_Route:
+				this->routes.push_back(string((const char *) view.value, view.length));
+				break;
+			case ATTRIB_Framed_IP_Address:
+				if (!framedip)
+				{
+					this->framedip=view.ipFromBuf();
+					framedip=true;
+				}
+				break;
+			case ATTRIB_Framed_IPv6_Route:
+				this->routes6.push_back(string((const char *) view.value, view.length));
+				break;
+			case ATTRIB_Framed_IPv6_Address:
+				if (!framedip6)
+				{
+					this->framedip6=view.ip6FromBuf();
+					framedip6=true;
+				}
+				break;
+			case ATTRIB_Acct_Interim_Interval:
+				if (view.length==4 && !interval)
+				{
+					this->acctinteriminterval=view.intFromBuf();
+					interval=true;
+				}
+				break;
+			case ATTRIB_Vendor_Specific:
+				//the vendor id and the sub attributes, every
+				//sub attribute has the type and the length
+				if (view.length<4)
+				{
+					skipped++;
+					break;
+				}
+				memcpy(&vendor, view.value, 4);
+				vsa.vendor=ntohl(vendor);
+				for (pos=4; pos<view.length; pos+=view.value[pos+1])
+				{
+					if (pos+2>view.length || view.value[pos+1]<2 || pos+view.value[pos+1]>view.length)
+					{
+						skipped++;
+						break;
+					}
+					vsa.type=view.value[pos];
+					vsa.value.assign((const char *) view.value+pos+2, view.value[pos+1]-2);
+					this->vsas.push_back(vsa);
+				}
+				break;
+			case ATTRIB_Reply_Message:
+				this->replymessage.append((const char *) view.value, view.length);
+				break;
+		}
+	}
+	return skipped;
+}
+
+/** The method sets the attributes of the reply at a user. The routes are
+ * joined with ';' and the vendor specific attributes are written into the
+ * buffer for the vsa script: the vendor id, the type, the length and the value.
+ * The framed ips are only set if they are in the reply.
+ * @param user The user.
+ */
+void AccessReply::apply(User *user)
+{
+	Octet				*buf=NULL;
+	unsigned int		len=0, i=0;
+	uint32_t			vendor;
+	
+	user->setFramedRoutes(this->getRoutes());
+	user->setFramedRoutes6(this->getRoutes6());
+	if (!this->framedip.empty())
+	{
+		user->setFramedIp(this->framedip);
+	}
+	if (!this->framedip6.empty())
+	{
+		user->setFramedIp6(this->framedip6);
+	}
+	user->setAcctInterimInterval(this->acctinteriminterval);
+	
+	for (vector<AccessReplyVsa>::iterator it=this->vsas.begin(); it!=this->vsas.end(); it++)
+	{
+		len+=it->value.size()+6;
+	}
+	if (len>0)
+	{
+		buf=new Octet[len];
+		for (vector<AccessReplyVsa>::iterator it=this->vsas.begin(); it!=this->vsas.end(); it++)
+		{
+			vendor=htonl(it->vendor);
+			memcpy(buf+i, &vendor, 4);
+			buf[i+4]=it->type;
+			buf[i+5]=it->value.size()+2;
+			memcpy(buf+i+6, it->value.data(), it->value.size());
+			i+=it->value.size()+6;
+		}
+	}
+	if (user->getVsaBuf()!=NULL)
+	{
+		delete [] user->getVsaBuf();
+	}
+	user->setVsaBuf(buf);
+	user->setVsaBufLen(len);
+}
+
+/** The method joins the Framed-Route attributes like the routes of the user.
+ * @return The routes delimited by ';'.
+ */
+string AccessReply::getRoutes(void)
+{
+	string routes;
+	
+	for (vector<string>::iterator it=this->routes.begin(); it!=this->routes.end(); it++)
+	{
+		routes.append(*it);
+		routes.append(";");
+	}
+	return routes;
+}
+
+/** The method joins the Framed-IPv6-Route attributes like the routes of the user.
+ * @return The routes delimited by ';'.
+ */
+string AccessReply::getRoutes6(void)
+{
+	string routes;
+	
+	for (vector<string>::iterator it=this->routes6.begin(); it!=this->routes6.end(); it++)
+	{
+		routes.append(*it);
+		routes.append(";");
+	}
+	return routes;
+}
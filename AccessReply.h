@@ -0,0 +1,69 @@
+/*
+ *  radiusplugin -- An OpenVPN plugin for do radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+ 
+#ifndef _ACCESS_REPLY_H_
+#define _ACCESS_REPLY_H_
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "User.h"
+
+using namespace std;
+
+class RadiusPacket;
+
+/** The class represents a sub attribute of a vendor specific attribute.*/
+class AccessReplyVsa
+{
+public:
+	uint32_t	vendor;		/**<The vendor id.*/
+	Octet		type;		/**<The vendor type of the attribute.*/
+	string		value;		/**<The value in the network format.*/
+};
+
+/** The class holds the attributes of an Access-Accept which are used by the plugin.
+ * It is filled by parse() in one pass over the response and it is sent from 
+ * the authentication background process to the foreground process, 
+ * see IpcSocket::send(AccessReply *).*/
+class AccessReply
+{
+public:
+	vector<string>			routes;			/**<The values of the Framed-Route attributes.*/
+	vector<string>			routes6;		/**<The values of the Framed-IPv6-Route attributes.*/
+	string					framedip;		/**<The first Framed-IP-Address or an empty string.*/
+	string					framedip6;		/**<The first Framed-IPv6-Address or an empty string.*/
+	int						acctinteriminterval;	/**<The Acct-Interim-Interval or 0.*/
+	vector<AccessReplyVsa>	vsas;			/**<The sub attributes of the vendor specific attributes.*/
+	string					replymessage;	/**<The Reply-Message attributes.*/
+	
+	AccessReply(void);
+	
+	void clear(void);
+	int parse(RadiusPacket *);
+	void apply(User *);
+	
+	string getRoutes(void);
+	string getRoutes6(void);
+};
+
+#endif //_ACCESS_REPLY_H_
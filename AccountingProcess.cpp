@@ -332,7 +332,7 @@ done:
 
 int AccountingProcess::callVsaScript(PluginContext * context, User * user, unsigned int action, unsigned int rekeying)
 {
-    char * route;
+    vector<string> routes;
     Octet * buf;
     int buflen = 3 * sizeof(int);
     if (user->getUsername().length() != 0)
@@ -360,16 +360,11 @@ int AccountingProcess::callVsaScript(PluginContext * context, User * user, unsig
         buflen=buflen+user->getVsaBufLen() +2*sizeof(int);
     }
 
-    char routes[user->getFramedRoutes().length()+1];
-    strncpy(routes, user->getFramedRoutes().c_str(), user->getFramedRoutes().length());
-    routes[user->getFramedRoutes().length()]=0;
-    if ((route = strtok(routes,";")) != NULL)
+    //the routes were validated when they were set, they are passed in the canonical format
+    for (vector<FramedRoute>::const_iterator route=user->getRoutes().begin(); route!=user->getRoutes().end(); route++)
     {
-        buflen=buflen+strlen(route)+2*sizeof(int);
-        while ((route = strtok(NULL,";"))!= NULL)
-        {
-            buflen=buflen+strlen(route)+2*sizeof(int);
-        }
+        routes.push_back(route->toString());
+        buflen=buflen+routes.back().length()+2*sizeof(int);
     }
     try{
       buf = new Octet[buflen];
@@ -444,30 +439,16 @@ int AccountingProcess::callVsaScript(PluginContext * context, User * user, unsig
         memcpy( buf+i, user->getUntrustedPort().c_str(),user->getUntrustedPort().length());
         i=i+user->getUntrustedPort().length();
     }
-    strncpy(routes, user->getFramedRoutes().c_str(), user->getFramedRoutes().length());
-
-    routes[user->getFramedRoutes().length()]=0;
-    if ((route = strtok(routes,";")) != NULL)
+    for (vector<string>::iterator route=routes.begin(); route!=routes.end(); route++)
     {
         value = htonl(106);
         memcpy(buf+i,&value, 4);
         i+=4;
-        value = htonl(strlen(route));
+        value = htonl(route->length());
         memcpy(buf+i,&value, 4);
         i+=4;
-        memcpy(buf+i, route, strlen(route));
-        i=i+strlen(route);
-        while ((route = strtok(NULL,";"))!= NULL)
-        {
-            value = htonl(106);
-            memcpy(buf+i,&value, 4);
-            i+=4;
-            value = htonl(strlen(route));
-            memcpy(buf+i,&value, 4);
-            i+=4;
-            memcpy(buf+i, route, strlen(route));
-            i=i+strlen(route);
-        }
+        memcpy(buf+i, route->data(), route->length());
+        i=i+route->length();
     }
 
     if (user->getVsaBufLen() != 0)
@@ -127,7 +127,8 @@ void AcctScheduler::delallUsers(PluginContext * context)
 /** The accounting method. When the method is called it
  * searches for users in activeuserlist for users who need an update.
  * If a user is found the sent and received bytes are read from the
- * OpenVpn status file.
+ * OpenVpn status file. The update packets of all users are sent together,
+ * the method returns when all responses are received or the requests timed out.
  * @param context The plugin context as an object from the class PluginContext.
  */
 
@@ -142,6 +143,8 @@ void AcctScheduler::doAccounting(PluginContext * context)
 	iter1=activeuserlist.begin();
 	iter2=activeuserlist.end();
 		
+	//the update packets are signed together and sent after the loop
+	context->radiusclient.startBatch();
 	
 	while (iter1!=iter2)
 	{
@@ -172,6 +175,10 @@ void AcctScheduler::doAccounting(PluginContext * context)
 		}
 		iter1++;
 	}
+	
+	//send the update packets and wait for the responses
+	context->radiusclient.sendBatch();
+	context->radiusclient.run();
 }
 
 /**The method parses the status file for accounting information. It reads the bytes sent
@@ -30,17 +30,18 @@
  * sends the result back to the foreground process. If the response
  * is an access accept ticket, 
  * it parses the response from the radius server for the following attributes and 
- * send them to the foregroundprocess too.:
+ * send them to the foregroundprocess too in an AccessReply:
  * - FramedIpAddress
  * - FramedRoutes
  * - AcctInterimInterval
+ * - vendor specific attributes
  * @param context The plugin context as an object from the class PluginContext.
  */
 
 
 void AuthenticationProcess::Authentication(PluginContext * context)
 {
-	UserAuth *		user; 		/**<The user to authenticate.*/
+	UserAuth *		user=NULL; 	/**<The user to authenticate.*/
   	int 			command;	/**<A command from the parent process.*/
     int step = 0;
 
@@ -113,34 +114,15 @@ void AuthenticationProcess::Authentication(PluginContext * context)
                     step++;//11
                     context->authsocketforegr.send(RESPONSE_SUCCEEDED);
 								     	
-			     	//send the routes to the parent process
+			     	//send the attributes of the Access-Accept to the parent process
                     step++;//12
-                    context->authsocketforegr.send(user->getFramedRoutes());
-					
-				//send the framed ip to the parent process
-                    step++;//13
-                    context->authsocketforegr.send(user->getFramedIp());
-										
-			     	//send the IPv6 routes to the parent process
-                    step++;//14
-                    context->authsocketforegr.send(user->getFramedRoutes6());
-					
-				//send the framed IPv6 to the parent process
-                    step++;//15
-                    context->authsocketforegr.send(user->getFramedIp6());
-										
-					//send the interval to the parent process
-                    step++;//16
-                    context->authsocketforegr.send(user->getAcctInterimInterval());
-			     	
-			     	//send the vsa buffer
-                    step++;//17
-                    context->authsocketforegr.send(user->getVsaBuf(), user->getVsaBufLen());
+                    context->authsocketforegr.send(user->getReply());
 			     	
 			     	
 			     	//free user_context_auth
-                    step++;//18
+                    step++;//13
                     delete user;
+                    user=NULL;
 			     	
 			     	if (DEBUG (context->getVerbosity()))
 		    			cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND  AUTH: Auth succeeded in radius_server().\n";
@@ -157,6 +139,7 @@ void AuthenticationProcess::Authentication(PluginContext * context)
 		    {
 		    	cerr << getTime() << e;
 		    	delete user;
+		    	user=NULL;
 		      	if (e.getErrnum()==Exception::SOCKETSEND || e.getErrnum()==Exception::SOCKETRECV)
 				{
 					goto done;
@@ -169,6 +152,7 @@ void AuthenticationProcess::Authentication(PluginContext * context)
 		    catch (...)
 		    {
 		    	delete user;
+		    	user=NULL;
 		      	goto done;
 		    }
 		  	
@@ -0,0 +1,69 @@
+/*
+ *  radiusplugin -- An OpenVPN plugin for do radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+ 
+#include "Completion.h"
+
+/** The constructor initializes an open slot.*/
+Completion::Completion(void)
+{
+	pthread_mutex_init(&this->mutex, NULL);
+	pthread_cond_init(&this->cond, NULL);
+	this->done=false;
+	this->result=0;
+}
+
+/** The destructor, the slot must not be used by another thread anymore.*/
+Completion::~Completion(void)
+{
+	pthread_cond_destroy(&this->cond);
+	pthread_mutex_destroy(&this->mutex);
+}
+
+/** The method sets the result and wakes the waiting thread. The
+ * slot must not be used after the call, the waiting thread can free it.
+ * @param r The result.
+ */
+void Completion::complete(int r)
+{
+	pthread_mutex_lock(&this->mutex);
+	this->result=r;
+	this->done=true;
+	pthread_cond_signal(&this->cond);
+	pthread_mutex_unlock(&this->mutex);
+}
+
+/** The method waits until the result is set.
+ * @return The result.
+ */
+int Completion::wait(void)
+{
+	int r;
+	
+	pthread_mutex_lock(&this->mutex);
+	while (!this->done)
+	{
+		pthread_cond_wait(&this->cond, &this->mutex);
+	}
+	r=this->result;
+	pthread_mutex_unlock(&this->mutex);
+	return r;
+}
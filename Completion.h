@@ -0,0 +1,52 @@
+/*
+ *  radiusplugin -- An OpenVPN plugin for do radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+ 
+#ifndef _COMPLETION_H_
+#define _COMPLETION_H_
+
+#include <pthread.h>
+
+/** The class is the completion slot of a request which OpenVPN waits for
+ * (AUTH_USER_PASS_VERIFY or CLIENT_CONNECT without a control file). The
+ * OpenVPN thread waits with wait() and the worker thread which handled
+ * the request sets the result with complete(). Every request has its own slot,
+ * so every waiting thread gets exactly its own result.*/
+class Completion
+{
+private:
+	pthread_mutex_t	mutex;		/**<The mutex for done and result.*/
+	pthread_cond_t	cond;		/**<The condition which is signaled by complete().*/
+	bool			done;		/**<Is true if the result is set.*/
+	int				result;		/**<The result of the request, e.g. OPENVPN_PLUGIN_FUNC_SUCCESS.*/
+	
+	Completion(const Completion &);
+	Completion & operator=(const Completion &);
+	
+public:
+	Completion(void);
+	~Completion(void);
+	
+	void complete(int);
+	int wait(void);
+};
+
+#endif //_COMPLETION_H_
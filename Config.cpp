@@ -37,6 +37,9 @@ Config::Config(void)
 	this->accountingonly=false;
 	this->nonfatalaccounting=false;
 	this->defacctinteriminterval=0;
+	this->authworkers=1;
+	this->firstnasport=1;
+	this->lastnasport=1048575;
 	this->ccdPath="";
 	this->openvpnconfig="";
 	this->vsanamedpipe="";
@@ -69,6 +72,9 @@ Config::Config(char * configfile)
 	this->accountingonly=false;
 	this->nonfatalaccounting=false;
 	this->defacctinteriminterval=0;
+	this->authworkers=1;
+	this->firstnasport=1;
+	this->lastnasport=1048575;
 	this->parseConfigFile(configfile);
 	
 }
@@ -203,10 +209,47 @@ int Config::parseConfigFile(const char * configfile)
 						return BAD_FILE;
 					this->defacctinteriminterval=(int)defacctinteriminterval;
 				}
+				if (strncmp(line.c_str(),"authworkers=",12)==0)
+				{
+
+					string stmp=line.substr(12,line.size()-12);
+					deletechars(&stmp);
+					char *stemp;
+					long authworkers = strtol(stmp.c_str(), &stemp, 0);
+					if (stemp == stmp.c_str() || *stemp != '\0' || authworkers < 1 || authworkers > MAX_AUTH_WORKERS)
+						return BAD_FILE;
+					this->authworkers=(int)authworkers;
+				}
+				if (strncmp(line.c_str(),"firstnasport=",13)==0)
+				{
+
+					string stmp=line.substr(13,line.size()-13);
+					deletechars(&stmp);
+					char *stemp;
+					long firstnasport = strtol(stmp.c_str(), &stemp, 0);
+					if (stemp == stmp.c_str() || *stemp != '\0' || firstnasport < 1 || firstnasport > MAX_NAS_PORT)
+						return BAD_FILE;
+					this->firstnasport=(int)firstnasport;
+				}
+				if (strncmp(line.c_str(),"lastnasport=",12)==0)
+				{
+
+					string stmp=line.substr(12,line.size()-12);
+					deletechars(&stmp);
+					char *stemp;
+					long lastnasport = strtol(stmp.c_str(), &stemp, 0);
+					if (stemp == stmp.c_str() || *stemp != '\0' || lastnasport < 1 || lastnasport > MAX_NAS_PORT)
+						return BAD_FILE;
+					this->lastnasport=(int)lastnasport;
+				}
 			}
 			
 		}
 		file.close();
+		if (this->firstnasport > this->lastnasport)
+		{
+			return BAD_FILE;
+		}
 		// if the main files contains references to other config files
 		// we don't need to care about recursive includes, OpenVPN does it already
 		list<string> configfiles; 
@@ -616,3 +659,33 @@ void Config::setDefAcctInterimInterval(int b)
 {
  this->defacctinteriminterval=b; 
 }
+
+int Config::getAuthWorkers(void)
+{
+ return this->authworkers; 
+}
+
+void Config::setAuthWorkers(int n)
+{
+ this->authworkers=n; 
+}
+
+int Config::getFirstNasPort(void)
+{
+ return this->firstnasport; 
+}
+
+void Config::setFirstNasPort(int port)
+{
+ this->firstnasport=port; 
+}
+
+int Config::getLastNasPort(void)
+{
+ return this->lastnasport; 
+}
+
+void Config::setLastNasPort(int port)
+{
+ this->lastnasport=port; 
+}
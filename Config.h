@@ -33,6 +33,11 @@
 #include <utility> 
 using namespace std;
 
+/** The maximal number of authentication workers, see the option authworkers.*/
+#define MAX_AUTH_WORKERS 64
+/** The largest NAS port which can be configured, see the option lastnasport.*/
+#define MAX_NAS_PORT 16777215
+
 /**This class represents the configurations attributes (without radius configuration) which 
  * can set in the configuration file and methods for the attributes.
  */
@@ -56,6 +61,9 @@ private:
         bool accountingonly;			/**<Only the accounting is done by the plugin.*/
 	bool nonfatalaccounting;		/**<If errors during the accounting occurs, the users can still connect.*/
 	int defacctinteriminterval;		/**<Default Acct-Interim-Interval in seconds.*/
+	int authworkers;				/**<The number of authentication threads and background processes.*/
+	int firstnasport;				/**<The first NAS port which is given to the users.*/
+	int lastnasport;				/**<The last NAS port which is given to the users.*/
 	void deletechars(string * );
 	
 public:
@@ -114,6 +122,15 @@ public:
 	int getDefAcctInterimInterval(void);
 	void setDefAcctInterimInterval(int);
 	
+	int getAuthWorkers(void);
+	void setAuthWorkers(int);
+	
+	int getFirstNasPort(void);
+	void setFirstNasPort(int);
+	
+	int getLastNasPort(void);
+	void setLastNasPort(int);
+	
 	string getOpenVPNConfig(void);
 	void setOpenVPNConfig(string);
 };
@@ -0,0 +1,278 @@
+/*
+ *  radiusplugin -- An OpenVPN plugin for do radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+ 
+#include "FramedRoute.h"
+#include <iostream>
+#include <cstring>
+
+/** The maximal length of a token of a route: an IPv6 address and "/128".*/
+#define FRAMED_ROUTE_TOKEN_LEN	(INET6_ADDRSTRLEN+5)
+
+/** Copies the next token of a route into a buffer, the tokens are 
+ * delimited by spaces or tabs.
+ * @param pos A pointer to the position in the route, it is moved behind the token.
+ * @param end The end of the route.
+ * @param buf The buffer for the token, it is terminated with 0.
+ * @param size The size of the buffer.
+ * @return The length of the token, 0 if there is no further token, -1 if the token doesn't fit into the buffer.*/
+static int nextToken(const char ** pos, const char * end, char * buf, int size)
+{
+	const char * p=*pos;
+	int len=0;
+	
+	while (p < end && (*p==' ' || *p=='\t'))
+	{
+		p++;
+	}
+	while (p < end && *p!=' ' && *p!='\t' && *p!='\0')
+	{
+		if (len >= size-1)
+		{
+			return -1;
+		}
+		buf[len++]=*p++;
+	}
+	buf[len]='\0';
+	*pos=p;
+	return len;
+}
+
+/** Converts a decimal number without sign.
+ * @param str The number, terminated with 0.
+ * @param max The maximal value.
+ * @return The number or -1 if the string is no number or the number is greater than max.*/
+static int parseNumber(const char * str, int max)
+{
+	long value=0;
+	
+	if (*str=='\0')
+	{
+		return -1;
+	}
+	for (; *str!='\0'; str++)
+	{
+		if (*str < '0' || *str > '9')
+		{
+			return -1;
+		}
+		value=value*10+(*str-'0');
+		if (value > max)
+		{
+			return -1;
+		}
+	}
+	return (int) value;
+}
+
+/** The constructor initializes an empty IPv4 route.*/
+FramedRoute::FramedRoute(void)
+{
+	this->family=AF_INET;
+	memset(this->prefix,0,sizeof(this->prefix));
+	this->prefixlen=0;
+	memset(this->gateway,0,sizeof(this->gateway));
+	this->hasgateway=false;
+	this->metric=-1;
+}
+
+/** The method parses and validates one route. The prefix length is optional,
+ * a route without it is a host route. The length of the gateway (e.g. "10.0.0.1/32")
+ * and the tokens behind the metric are ignored. The method doesn't allocate memory.
+ * @param family The address family of the route, AF_INET for Framed-Route or AF_INET6 for Framed-IPv6-Route.
+ * @param route The route, it doesn't need to be terminated with 0.
+ * @param len The length of the route.
+ * @return 0 if the route is valid, else -1.*/
+int FramedRoute::parse(int family, const char * route, int len)
+{
+	char token[FRAMED_ROUTE_TOKEN_LEN];
+	const char * end=route+len;
+	char * slash;
+	int maxlen, n, i;
+	
+	if (family!=AF_INET && family!=AF_INET6)
+	{
+		return -1;
+	}
+	maxlen=(family==AF_INET) ? 32 : 128;
+	*this=FramedRoute();
+	this->family=family;
+	
+	//the destination with the prefix length
+	if (nextToken(&route,end,token,sizeof(token)) <= 0)
+	{
+		return -1;
+	}
+	this->prefixlen=maxlen;
+	if ((slash=strchr(token,'/'))!=NULL)
+	{
+		*slash='\0';
+		if ((this->prefixlen=parseNumber(slash+1,maxlen)) < 0)
+		{
+			return -1;
+		}
+	}
+	if (inet_pton(family,token,this->prefix)!=1)
+	{
+		return -1;
+	}
+	
+	//the optional gateway
+	if ((n=nextToken(&route,end,token,sizeof(token))) < 0)
+	{
+		return -1;
+	}
+	if (n==0)
+	{
+		return 0;
+	}
+	if ((slash=strchr(token,'/'))!=NULL)
+	{
+		*slash='\0';
+	}
+	if (inet_pton(family,token,this->gateway)!=1)
+	{
+		return -1;
+	}
+	for (i=0; i < maxlen/8; i++)
+	{
+		if (this->gateway[i]!=0)
+		{
+			this->hasgateway=true;
+		}
+	}
+	
+	//the optional metric
+	if ((n=nextToken(&route,end,token,sizeof(token))) < 0)
+	{
+		return -1;
+	}
+	if (n > 0 && (this->metric=parseNumber(token,0x7fffffff)) < 0)
+	{
+		return -1;
+	}
+	return 0;
+}
+
+/** The getter method for the destination network.
+ * @return The prefix as a string, without the prefix length.*/
+string FramedRoute::getPrefix(void) const
+{
+	char buf[INET6_ADDRSTRLEN];
+	
+	if (inet_ntop(this->family,this->prefix,buf,sizeof(buf))==NULL)
+	{
+		return "";
+	}
+	return buf;
+}
+
+/** The getter method for the netmask of an IPv4 route.
+ * @return The prefix length as a dotted netmask, an empty string for IPv6 routes.*/
+string FramedRoute::getNetmask(void) const
+{
+	char buf[INET_ADDRSTRLEN];
+	struct in_addr mask;
+	
+	if (this->family!=AF_INET)
+	{
+		return "";
+	}
+	mask.s_addr=htonl(this->prefixlen==0 ? 0 : 0xffffffffUL << (32-this->prefixlen));
+	inet_ntop(AF_INET,&mask,buf,sizeof(buf));
+	return buf;
+}
+
+/** The getter method for the gateway.
+ * @return The gateway as a string or an empty string if the route has no gateway.*/
+string FramedRoute::getGateway(void) const
+{
+	char buf[INET6_ADDRSTRLEN];
+	
+	if (!this->hasgateway || inet_ntop(this->family,this->gateway,buf,sizeof(buf))==NULL)
+	{
+		return "";
+	}
+	return buf;
+}
+
+/** The method formats the route in the format of the attribute.
+ * @return The route as "prefix/prefixlen [gateway] [metric]", the unspecified
+ * address is used as the gateway if the route has only a metric.*/
+string FramedRoute::toString(void) const
+{
+	char buf[16];
+	string route;
+	
+	snprintf(buf,sizeof(buf),"/%d",this->prefixlen);
+	route=this->getPrefix()+buf;
+	if (this->hasgateway)
+	{
+		route+=" "+this->getGateway();
+	}
+	else if (this->metric >= 0)
+	{
+		route+=(this->family==AF_INET) ? " 0.0.0.0" : " ::";
+	}
+	if (this->metric >= 0)
+	{
+		snprintf(buf,sizeof(buf)," %d",this->metric);
+		route+=buf;
+	}
+	return route;
+}
+
+/** The method parses a list of routes, delimited by ';'. Invalid routes are 
+ * reported and skipped.
+ * @param family The address family of the routes, AF_INET or AF_INET6.
+ * @param routes The routes.
+ * @param list The list for the routes, it is cleared before.
+ * @return The number of invalid routes.*/
+int FramedRoute::parseList(int family, const string & routes, vector<FramedRoute> * list)
+{
+	FramedRoute route;
+	size_t pos=0, next;
+	int invalid=0;
+	
+	list->clear();
+	while (pos < routes.size())
+	{
+		next=routes.find(';',pos);
+		if (next==string::npos)
+		{
+			next=routes.size();
+		}
+		if (routes.find_first_not_of(" \t",pos)<next)
+		{
+			if (route.parse(family,routes.data()+pos,next-pos)==0)
+			{
+				list->push_back(route);
+			}
+			else
+			{
+				cerr << "RADIUS-PLUGIN: Invalid " << (family==AF_INET ? "Framed-Route" : "Framed-IPv6-Route") << " is ignored: " << routes.substr(pos,next-pos) << ".\n";
+				invalid++;
+			}
+		}
+		pos=next+1;
+	}
+	return invalid;
+}
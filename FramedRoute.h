@@ -0,0 +1,61 @@
+/*
+ *  radiusplugin -- An OpenVPN plugin for do radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+ 
+#ifndef _FRAMED_ROUTE_H_
+#define _FRAMED_ROUTE_H_
+
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+using namespace std;
+
+/** The class represents one route of a Framed-Route or Framed-IPv6-Route
+ * attribute, the format of the attribute is "prefix[/prefixlen] [gateway[/bits]] [metric] ...", 
+ * see RFC 2865 and RFC 3162. The addresses are stored in the network format, so a
+ * route is validated once by parse() and can be copied without allocations.*/
+class FramedRoute
+{
+public:
+	int				family;			/**<The address family, AF_INET or AF_INET6.*/
+	unsigned char	prefix[16];		/**<The destination network in the network format.*/
+	int				prefixlen;		/**<The length of the prefix in bits.*/
+	unsigned char	gateway[16];	/**<The gateway in the network format.*/
+	bool			hasgateway;		/**<Is false if the route has no gateway or it is unspecified (0.0.0.0 or ::).*/
+	int				metric;			/**<The metric or -1 if the route has no metric.*/
+	
+	FramedRoute(void);
+	
+	int parse(int family, const char * route, int len);
+	
+	string getPrefix(void) const;
+	string getNetmask(void) const;
+	string getGateway(void) const;
+	string toString(void) const;
+	
+	static int parseList(int family, const string & routes, vector<FramedRoute> * list);
+};
+
+#endif //_FRAMED_ROUTE_H_
@@ -0,0 +1,203 @@
+/*
+ *  radiusplugin -- An OpenVPN plugin for do radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+ 
+#include "HandoffQueue.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <iostream>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+using namespace std;
+
+/** The constructor allocates the ring and creates the eventfd or the pipe for the wakeups.
+ * @param size The number of slots, it is rounded up to a power of 2.
+ * @param onewakeup If true every wait() takes one wakeup, else all.
+ */
+HandoffQueue::HandoffQueue(unsigned long size, bool onewakeup)
+{
+	unsigned long n=2, i;
+	
+	while (n < size)
+	{
+		n<<=1;
+	}
+	this->cells=new HandoffCell[n];
+	for (i=0; i < n; i++)
+	{
+		this->cells[i].sequence=i;
+		this->cells[i].user=NULL;
+	}
+	this->mask=n-1;
+	this->pushpos=0;
+	this->poppos=0;
+	this->onewakeup=onewakeup;
+	
+#ifdef __linux__
+	this->fd[0]=this->fd[1]=eventfd(0, EFD_CLOEXEC | (onewakeup ? EFD_SEMAPHORE : 0));
+	if (this->fd[0] < 0)
+#else
+	if (pipe(this->fd) < 0)
+#endif
+	{
+		cerr << "RADIUS-PLUGIN: Could not create the wakeup descriptor of a queue.\n";
+		this->fd[0]=this->fd[1]=-1;
+	}
+#ifndef __linux__
+	else
+	{
+		fcntl(this->fd[0], F_SETFD, FD_CLOEXEC);
+		fcntl(this->fd[1], F_SETFD, FD_CLOEXEC);
+		//the producer must not block, if the pipe is full there are enough wakeups
+		fcntl(this->fd[1], F_SETFL, fcntl(this->fd[1], F_GETFL) | O_NONBLOCK);
+	}
+#endif
+}
+
+/** The destructor frees the ring and closes the wakeup descriptor, the users 
+ * in the queue are not freed.*/
+HandoffQueue::~HandoffQueue(void)
+{
+	delete [] this->cells;
+	if (this->fd[0] >= 0)
+	{
+		close(this->fd[0]);
+	}
+	if (this->fd[1]!=this->fd[0] && this->fd[1] >= 0)
+	{
+		close(this->fd[1]);
+	}
+}
+
+/** The method appends a user to the queue and wakes a consumer. It
+ * doesn't block, more producers can push at the same time.
+ * @param user The user.
+ * @return False if the queue is full.
+ */
+bool HandoffQueue::push(UserPlugin * user)
+{
+	HandoffCell * cell;
+	unsigned long pos=__atomic_load_n(&this->pushpos, __ATOMIC_RELAXED);
+	long diff;
+	
+	for (;;)
+	{
+		cell=&this->cells[pos & this->mask];
+		diff=(long) (__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) - pos);
+		if (diff==0)
+		{
+			//the slot is free, reserve it
+			if (__atomic_compare_exchange_n(&this->pushpos, &pos, pos+1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			{
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			//the slot is not read since the last round
+			return false;
+		}
+		else
+		{
+			pos=__atomic_load_n(&this->pushpos, __ATOMIC_RELAXED);
+		}
+	}
+	cell->user=user;
+	__atomic_store_n(&cell->sequence, pos+1, __ATOMIC_RELEASE);
+	this->wake(1);
+	return true;
+}
+
+/** The method takes the first user from the queue. It doesn't block,
+ * more consumers can pop at the same time.
+ * @return The user or NULL if the queue is empty.
+ */
+UserPlugin * HandoffQueue::pop(void)
+{
+	HandoffCell * cell;
+	unsigned long pos=__atomic_load_n(&this->poppos, __ATOMIC_RELAXED);
+	UserPlugin * user;
+	long diff;
+	
+	for (;;)
+	{
+		cell=&this->cells[pos & this->mask];
+		diff=(long) (__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) - (pos+1));
+		if (diff==0)
+		{
+			if (__atomic_compare_exchange_n(&this->poppos, &pos, pos+1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			{
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			//the slot is not written
+			return NULL;
+		}
+		else
+		{
+			pos=__atomic_load_n(&this->poppos, __ATOMIC_RELAXED);
+		}
+	}
+	user=cell->user;
+	//the slot can be written in the next round
+	__atomic_store_n(&cell->sequence, pos+this->mask+1, __ATOMIC_RELEASE);
+	return user;
+}
+
+/** The method blocks until there is a wakeup. The consumer must call pop() until
+ * it returns NULL before it waits, a wakeup can be there without a user, if the user
+ * was taken before.
+ */
+void HandoffQueue::wait(void)
+{
+#ifdef __linux__
+	uint64_t count;
+	
+	while (read(this->fd[0], &count, sizeof(count)) < 0 && errno==EINTR);
+#else
+	char buf[256];
+	
+	while (read(this->fd[0], buf, this->onewakeup ? 1 : sizeof(buf)) < 0 && errno==EINTR);
+#endif
+}
+
+/** The method adds wakeups, e.g. to stop the consumers.
+ * @param n The number of wakeups.
+ */
+void HandoffQueue::wake(unsigned int n)
+{
+#ifdef __linux__
+	uint64_t count=n;
+	
+	while (write(this->fd[1], &count, sizeof(count)) < 0 && errno==EINTR);
+#else
+	char c=0;
+	
+	for (; n > 0; n--)
+	{
+		while (write(this->fd[1], &c, 1) < 0 && errno==EINTR);
+	}
+#endif
+}
@@ -0,0 +1,76 @@
+/*
+ *  radiusplugin -- An OpenVPN plugin for do radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+ 
+#ifndef _HANDOFFQUEUE_H_
+#define _HANDOFFQUEUE_H_
+
+#include <stdint.h>
+#include <unistd.h>
+
+class UserPlugin;
+
+/** The default number of users which can wait in a queue, a power of 2.*/
+#define HANDOFF_QUEUE_SIZE 4096
+
+/** A slot of the ring of the queue.*/
+class HandoffCell
+{
+public:
+	unsigned long	sequence;	/**<The position of the ring for which the slot can be written (sequence==pos) or read (sequence==pos+1).*/
+	UserPlugin		*user;		/**<The user in the slot.*/
+};
+
+/** The class is a bounded queue for the users which are handed from the OpenVPN
+ * callbacks to the threads of the plugin. push() and pop() are lock-free (a ring with
+ * a sequence number per slot), so OpenVPN never waits for a thread of the plugin.
+ * The consumers sleep in wait() on an eventfd (a pipe on other systems than Linux),
+ * every push() adds one wakeup. In the mode onewakeup every wait() takes one 
+ * wakeup, so every consumer gets its own user (authentication workers), else 
+ * wait() takes all wakeups and the consumer drains the queue with pop().*/
+class HandoffQueue
+{
+private:
+	HandoffCell		*cells;			/**<The ring.*/
+	unsigned long	mask;			/**<The size of the ring minus 1.*/
+	bool			onewakeup;		/**<If true wait() takes only one wakeup.*/
+	int				fd[2];			/**<The eventfd (fd[0]==fd[1]) or the pipe for the wakeups.*/
+	char			pad1[64];
+	unsigned long	pushpos;		/**<The next position to write, on an own cache line.*/
+	char			pad2[64];
+	unsigned long	poppos;			/**<The next position to read, on an own cache line.*/
+	char			pad3[64];
+	
+	HandoffQueue(const HandoffQueue &);
+	HandoffQueue & operator=(const HandoffQueue &);
+	
+public:
+	HandoffQueue(unsigned long size=HANDOFF_QUEUE_SIZE, bool onewakeup=false);
+	~HandoffQueue(void);
+	
+	bool push(UserPlugin *);
+	UserPlugin * pop(void);
+	
+	void wait(void);
+	void wake(unsigned int);
+};
+
+#endif //_HANDOFFQUEUE_H_
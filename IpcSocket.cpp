@@ -138,6 +138,37 @@ void IpcSocket::send(int num)
 }
 
 
+/**The method sends the attributes of an Access-Accept via the socket.
+ * The routes and the vendor specific attributes are sent with their number,
+ * the values are sent as strings.
+ * @param reply The attributes.
+ * @throws Exception::SOCKETSEND if a value could not send correctly.
+ */
+void IpcSocket::send(AccessReply *reply)
+{
+	this->send((int) reply->routes.size());
+	for (vector<string>::iterator it=reply->routes.begin(); it!=reply->routes.end(); it++)
+	{
+		this->send(*it);
+	}
+	this->send((int) reply->routes6.size());
+	for (vector<string>::iterator it=reply->routes6.begin(); it!=reply->routes6.end(); it++)
+	{
+		this->send(*it);
+	}
+	this->send(reply->framedip);
+	this->send(reply->framedip6);
+	this->send(reply->acctinteriminterval);
+	this->send((int) reply->vsas.size());
+	for (vector<AccessReplyVsa>::iterator it=reply->vsas.begin(); it!=reply->vsas.end(); it++)
+	{
+		this->send((int) it->vendor);
+		this->send((int) it->type);
+		this->send(it->value);
+	}
+	this->send(reply->replymessage);
+}
+
 /**The method receives an integer from the socket.
  * @return The received integer.
  * @throws Exception::SOCKETRECV If the received size
@@ -194,7 +225,7 @@ string IpcSocket::recvStr(void)
           {
             throw Exception(Exception::SOCKETRECV);
           }
-          str=buffer;
+          str.assign(buffer, len);
           delete [] buffer;
         }
     return str;
@@ -237,3 +268,47 @@ void IpcSocket::recvBuf(User * user)
     
 }
 
+/**The method receives the attributes of an Access-Accept, 
+ * which were sent with send(AccessReply *).
+ * @param reply The attributes, the old attributes are removed.
+ * @throws Exception::SOCKETRECV If a value is not received correctly
+ * or a number is negative.
+ */
+void IpcSocket::recvReply(AccessReply *reply)
+{
+	AccessReplyVsa vsa;
+	int i, n;
+	
+	reply->clear();
+	if ((n=this->recvInt())<0)
+	{
+		throw Exception(Exception::SOCKETRECV);
+	}
+	for (i=0; i<n; i++)
+	{
+		reply->routes.push_back(this->recvStr());
+	}
+	if ((n=this->recvInt())<0)
+	{
+		throw Exception(Exception::SOCKETRECV);
+	}
+	for (i=0; i<n; i++)
+	{
+		reply->routes6.push_back(this->recvStr());
+	}
+	reply->framedip=this->recvStr();
+	reply->framedip6=this->recvStr();
+	reply->acctinteriminterval=this->recvInt();
+	if ((n=this->recvInt())<0)
+	{
+		throw Exception(Exception::SOCKETRECV);
+	}
+	for (i=0; i<n; i++)
+	{
+		vsa.vendor=(uint32_t) this->recvInt();
+		vsa.type=(Octet) this->recvInt();
+		vsa.value=this->recvStr();
+		reply->vsas.push_back(vsa);
+	}
+	reply->replymessage=this->recvStr();
+}
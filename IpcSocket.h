@@ -26,6 +26,7 @@
 #include <string>
 #include <cstring>
 #include "User.h"
+#include "AccessReply.h"
 #include "Exception.h"
 #include <sys/socket.h>
 #include <netinet/in.h>
@@ -62,12 +63,16 @@ public:
 	
 	void send(Octet *, ssize_t);
 	
+	void send(AccessReply *);
+	
 	int recvInt(void);
 	
 	string recvStr(void);
 	
 	void recvBuf(User *);
 	
+	void recvReply(AccessReply *);
+	
 };
 
 #endif //_IPCSOCKET_H_
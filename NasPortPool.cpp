@@ -0,0 +1,124 @@
+/*
+ *  radiusplugin -- An OpenVPN plugin for do radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+ 
+#include "NasPortPool.h"
+
+/** The constructor makes an empty pool, alloc() fails until init() is called.*/
+NasPortPool::NasPortPool(void)
+{
+	this->first=1;
+	this->last=0;
+}
+
+/** The method builds the bitmaps for a range of ports, all ports are free.
+ * @param first The first port.
+ * @param last The last port, it must not be smaller than first.
+ */
+void NasPortPool::init(int first, int last)
+{
+	unsigned long n=(unsigned long) (last-first)+1, words, i;
+	
+	this->first=first;
+	this->last=last;
+	this->levels.clear();
+	
+	//level 0: a bit for every port, the bits after the last port stay 0
+	words=(n+63)/64;
+	this->levels.push_back(vector<uint64_t>(words, ~(uint64_t) 0));
+	if (n % 64)
+	{
+		this->levels[0][words-1]=((uint64_t) 1 << (n % 64))-1;
+	}
+	//the higher levels: a bit for every word of the level below
+	while (words > 1)
+	{
+		n=words;
+		words=(n+63)/64;
+		this->levels.push_back(vector<uint64_t>(words, 0));
+		for (i=0; i < n; i++)
+		{
+			this->levels.back()[i/64]|=(uint64_t) 1 << (i % 64);
+		}
+	}
+}
+
+/** The method takes the lowest free port.
+ * @return The port or 0 if all ports are used.
+ */
+int NasPortPool::alloc(void)
+{
+	unsigned long index=0, i;
+	int l;
+	
+	if (this->levels.empty() || this->levels.back()[0]==0)
+	{
+		return 0;
+	}
+	for (l=this->levels.size()-1; l >= 0; l--)
+	{
+		index=index*64+__builtin_ctzll(this->levels[l][index]);
+	}
+	//clear the bit, a word which gets 0 is cleared in the level above
+	i=index;
+	for (l=0; l < (int) this->levels.size(); l++)
+	{
+		this->levels[l][i/64]&=~((uint64_t) 1 << (i % 64));
+		if (this->levels[l][i/64]!=0)
+		{
+			break;
+		}
+		i/=64;
+	}
+	return this->first+(int) index;
+}
+
+/** The method gives a port back to the pool, ports which are not in the
+ * range or not used are ignored.
+ * @param port The port.
+ */
+void NasPortPool::free(int port)
+{
+	unsigned long i;
+	unsigned int l;
+	bool wasempty;
+	
+	if (this->levels.empty() || port < this->first || port > this->last)
+	{
+		return;
+	}
+	i=(unsigned long) (port-this->first);
+	if (this->levels[0][i/64] & ((uint64_t) 1 << (i % 64)))
+	{
+		return;
+	}
+	//set the bit, a word which was 0 is set in the level above
+	for (l=0; l < this->levels.size(); l++)
+	{
+		wasempty=(this->levels[l][i/64]==0);
+		this->levels[l][i/64]|=(uint64_t) 1 << (i % 64);
+		if (!wasempty)
+		{
+			break;
+		}
+		i/=64;
+	}
+}
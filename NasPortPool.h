@@ -0,0 +1,52 @@
+/*
+ *  radiusplugin -- An OpenVPN plugin for do radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+ 
+ 
+#ifndef _NASPORTPOOL_H_
+#define _NASPORTPOOL_H_
+
+#include <stdint.h>
+#include <vector>
+
+using std::vector;
+
+/** The class allocates the NAS ports of the users from a range of ports. The free
+ * ports are bits in a hierarchical bitmap: a bit in level 0 is set if the port is free, 
+ * a bit in a higher level is set if the word below has a free bit. alloc() goes down
+ * from the top word with ctz, so it finds the lowest free port in one word operation
+ * per level (4 levels for 16 million ports). The class is not locked, see PluginContext.*/
+class NasPortPool
+{
+private:
+	int		first;						/**<The first port of the range.*/
+	int		last;						/**<The last port of the range.*/
+	vector< vector<uint64_t> > levels;	/**<The bitmaps, levels[0] has a bit per port, the last level has one word.*/
+	
+public:
+	NasPortPool(void);
+	
+	void init(int, int);
+	int alloc(void);
+	void free(int);
+};
+
+#endif //_NASPORTPOOL_H_
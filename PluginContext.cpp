@@ -21,19 +21,25 @@
  
 #include "PluginContext.h"
 
+/** The constructor initializes a worker without background process and thread.
+ * @param context The context of the plugin.*/
+AuthWorker::AuthWorker(PluginContext * context)
+{
+	this->context=context;
+	this->pid=0;
+	this->started=false;
+}
 
 
 /** The constructor. All sockets all set to -1, the process ids and the
  * verbosity level are set to 0. The session id is set to to 1.*/
-PluginContext::PluginContext()
+PluginContext::PluginContext() : newusers(HANDOFF_QUEUE_SIZE, true), newacctusers(HANDOFF_QUEUE_SIZE, false)
 {
 	
   	this->authsocketforegr.setSocket(-1);
-  	this->authsocketbackgr.setSocket(-1);
 	this->acctsocketforegr.setSocket(-1);
 	this->acctsocketbackgr.setSocket(-1);
   	
-  	this->authpid=0;
   	this->acctpid=0;
  	
   	this->verb=0;
@@ -43,104 +49,152 @@ PluginContext::PluginContext()
 	this->startthread=true;
 
         pthread_mutex_init(&usermutex, NULL);
+        pthread_mutex_init(&loginmutex, NULL);
 }
 
-/** The destructor clears the users and nasportlist.*/
+/** The destructor releases the users and frees the authentication workers.*/
 PluginContext::~PluginContext()
 {
+	for (unsigned int i=0; i < this->authworkers.size(); i++)
+	{
+		delete this->authworkers[i];
+	}
+	this->authworkers.clear();
 	this->users.clear();
-	this->nasportlist.clear();
+	for (map<RadiusServerGroup *, list<UserPlugin *> >::iterator it=this->waitinglogins.begin(); it!=this->waitinglogins.end(); it++)
+	{
+		for (list<UserPlugin *>::iterator user=it->second.begin(); user!=it->second.end(); user++)
+		{
+			delete *user;
+		}
+	}
+	this->waitinglogins.clear();
 	pthread_mutex_destroy(&usermutex);
+	pthread_mutex_destroy(&loginmutex);
 }
 
-/** The method searches the first free nas port in a list.
- * @return The nas port.
+/** The method sets the range of the nas ports, all ports are free.
+ * @param first The first port.
+ * @param last The last port.
  */
-int PluginContext::addNasPort(void)
+void PluginContext::initNasPorts(int first, int last)
+{
+	pthread_mutex_lock(&usermutex);
+	this->nasports.init(first, last);
+	pthread_mutex_unlock(&usermutex);
+}
+
+/** The method counts a login of the server group of the user, the in-flight 
+ * limit (maxinflight) is shared by all authentication workers. If the limit is
+ * reached the user waits until a login of the group is finished, so the 
+ * workers can verify the users of the other groups in the meantime.
+ * @param group The authentication server group of the user.
+ * @param user The user.
+ * @return False if the user waits, it is given to a worker by finishLogin().
+ */
+bool PluginContext::startLogin(RadiusServerGroup *group, UserPlugin *user)
 {
-	int newport=0;
-	list<int>::iterator i;
-	list<int>::iterator j;
-	i=nasportlist.begin();
-	j=nasportlist.end();
+	bool started;
 	
-	if (this->nasportlist.empty())
+	if (group->getMaxInFlight()==0)
+	{
+		return true;
+	}
+	pthread_mutex_lock(&loginmutex);
+	if ((started=group->takeInFlight())==false)
 	{
-		newport=1;
-		this->nasportlist.push_front(newport);
+		this->waitinglogins[group].push_back(user);
 	}
+	pthread_mutex_unlock(&loginmutex);
+	return started;
+}
+
+/** The method is called when a login of a server group is finished.
+ * If a user of the group waits, it gets the login of the finished user.
+ * @param group The authentication server group of the finished user.
+ * @return The waiting user, the worker must verify it next, or NULL.
+ */
+UserPlugin * PluginContext::finishLogin(RadiusServerGroup *group)
+{
+	map<RadiusServerGroup *, list<UserPlugin *> >::iterator it;
+	UserPlugin *next=NULL;
 	
-	else
+	if (group->getMaxInFlight()==0)
+	{
+		return NULL;
+	}
+	pthread_mutex_lock(&loginmutex);
+	if ((it=this->waitinglogins.find(group))!=this->waitinglogins.end())
 	{
-		newport=1;
-		while( i != this->nasportlist.end()) 
+		next=it->second.front();
+		it->second.pop_front();
+		if (it->second.empty())
 		{
-		    if (newport < *i)
-		    {
-		    	j=i;
-		    	i=this->nasportlist.end();
-		    }
-		    else
-		    {
-		    	i++;
-		    	newport++;
-		    }
+			this->waitinglogins.erase(it);
 		}
-		this->nasportlist.insert(j, newport);
 	}
+	else
+	{
+		group->releaseInFlight();
+	}
+	pthread_mutex_unlock(&loginmutex);
+	return next;
+}
+
+/** The method takes the lowest free nas port.
+ * It is called from the worker threads, so the ports are locked.
+ * @return The nas port or 0 if all ports are used.
+ */
+int PluginContext::addNasPort(void)
+{
+	int newport;
+	
+	pthread_mutex_lock(&usermutex);
+	newport=this->nasports.alloc();
+	pthread_mutex_unlock(&usermutex);
 	return newport;
 }
 
-/**The method deletes the nas port from the list.
- * @param The nas port number to delete.
+/**The method frees the nas port.
+ * @param The nas port number to free.
  */
 void PluginContext::delNasPort(int num)
 {
-	this->nasportlist.remove(num);
+	pthread_mutex_lock(&usermutex);
+	this->nasports.free(num);
+	pthread_mutex_unlock(&usermutex);
 }
 
 /**The method adds an user to the user map of the foreground
- * process.
+ * process, the map takes a reference to the user.
  * @param newuser A pointer to the user.
  * @throws Exception::ALREADYAUTHENTICATED if the user could not add to the map, this happens if a user with the key is already in the list.
  */
 void PluginContext::addUser(UserPlugin * newuser)
 {
-	pair<map<string,UserPlugin *>::iterator,bool> success;
-	
-	success=users.insert(make_pair(newuser->getKey(),newuser));
-	
-	if(success.second==false)
+	if(this->users.insert(newuser->getKey(),newuser)==false)
 	{
 		throw Exception(Exception::ALREADYAUTHENTICATED);
 	}
-	else
-	{
-		this->sessionid++;
-	}
-	
+	__atomic_add_fetch(&this->sessionid, 1, __ATOMIC_RELAXED);
 }
 
-/**The method deletes the user from the map with the key.
+/**The method deletes the user from the map with the key and releases 
+ * the reference of the map, the user is deleted if nobody else holds a reference.
  * @param key The key of the user.
  */
 void PluginContext::delUser(string key)
 {
-	users.erase(key);	
+	this->users.erase(key);
 }
 
 /**The method finds a user in the user map.
  * @param key The key of the user.
- * @return A pointer to the user.
+ * @return A pointer to the user or NULL, the caller must call release() on the user if it is not needed any more.
  */
 UserPlugin * PluginContext::findUser(string key)
 {
-	map<string,UserPlugin *>::iterator iter =  users.find(key);
-	if (iter != users.end())
-	{
-		return iter->second;
-	}
-	return NULL;
+	return this->users.find(key);
 }
 
 
@@ -160,23 +214,20 @@ void PluginContext::setVerbosity(int v)
 	this->verb=v;
 }
 
-/** The getter method for the authentication
- * background process id.
- * @returns The process id.
- */
-pid_t PluginContext::getAuthPid(void)
-{				
-	return this->authpid;
-}
-
-/** The setter method for the authentication
- * background process id.
- * @param The process id.
+/** The method checks if an authentication background process was initialized.
+ * @returns True if at least one worker has a socket to its background process.
  */
-void PluginContext::setAuthPid(pid_t p)
+bool PluginContext::hasAuthWorkers(void)
 {
-	this->authpid=p;
-} 
+	for (unsigned int i=0; i < this->authworkers.size(); i++)
+	{
+		if (this->authworkers[i]->socket.getSocket() >= 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
 
 /** The getter method for the accounting
  * background process id.
@@ -202,98 +253,56 @@ void PluginContext::setAcctPid(pid_t p)
  */
 int PluginContext::getSessionId(void)
 {
-	return this->sessionid;
+	return __atomic_load_n(&this->sessionid, __ATOMIC_RELAXED);
 }
 
 
-/**The method adds an new user to the user list of users waiting for authentication
+/**The method adds an new user to the queue of users waiting for authentication
+ * and wakes one worker, it doesn't block.
  * @param newuser A pointer to the user.
+ * @return False if the queue is full.
  */
-void PluginContext::addNewUser(UserPlugin * newuser)
+bool PluginContext::addNewUser(UserPlugin * newuser)
 {
-  pthread_mutex_lock(&usermutex);
-  this->newusers.push_back(newuser);
-  pthread_mutex_unlock(&usermutex);
+  return this->newusers.push(newuser);
 }
 
-/**The method adds an new user to the user list of users waiting for accounting
+/**The method adds an new user to the queue of users waiting for accounting
+ * and wakes the accounting thread, it doesn't block.
  * @param newuser A pointer to the user.
+ * @return False if the queue is full.
  */
-void PluginContext::addNewAcctUser(UserPlugin * newuser)
+bool PluginContext::addNewAcctUser(UserPlugin * newuser)
 {
-  pthread_mutex_lock(&usermutex);
-  this->newacctusers.push_back(newuser);
-  pthread_mutex_unlock(&usermutex);
+  return this->newacctusers.push(newuser);
 }
 
-/**The method return the first element in the list of waiting for authentication users.
+/**The method return the first element in the queue of waiting for authentication users.
+ * @return The user or NULL if the queue is empty, another worker can have taken the user.
  */
 UserPlugin * PluginContext::getNewUser()
 {
-    
-      pthread_mutex_lock(&usermutex);
-      UserPlugin * user = this->newusers.front();
-      this->newusers.pop_front();
-      pthread_mutex_unlock(&usermutex);
-      return user;
-	
+      return this->newusers.pop();
 }
 
-/**The method return the first element in the list of waiting for accounting users.
+/**The method return the first element in the queue of waiting for accounting users.
+ * @return The user or NULL if the queue is empty.
  */
 UserPlugin * PluginContext::getNewAcctUser()
 {
-    
-      pthread_mutex_lock(&usermutex);
-      UserPlugin * user = this->newacctusers.front();
-      this->newacctusers.pop_front();
-      pthread_mutex_unlock(&usermutex);
-      return user;
-	
-}
-
-pthread_cond_t  * PluginContext::getCondSend(void )
-{
-  return &condsend;
-}
-pthread_cond_t  * PluginContext::getCondRecv(void )
-{
-  return &condrecv;
+      return this->newacctusers.pop();
 }
 
-pthread_mutex_t * PluginContext::getMutexSend(void )
+/**The method blocks an authentication worker until a user is added or the threads are stopped.*/
+void PluginContext::waitNewUser()
 {
-  return &mutexsend;
+      this->newusers.wait();
 }
 
-pthread_mutex_t * PluginContext::getMutexRecv(void )
+/**The method blocks the accounting thread until users are added or the thread is stopped.*/
+void PluginContext::waitNewAcctUser()
 {
-  return &mutexrecv;
-}
-
-pthread_cond_t  * PluginContext::getAcctCondSend(void )
-{
-  return &acctcondsend;
-}
-pthread_cond_t  * PluginContext::getAcctCondRecv(void )
-{
-  return &acctcondrecv;
-}
-
-pthread_mutex_t * PluginContext::getAcctMutexSend(void )
-{
-  return &acctmutexsend;
-}
-
-pthread_mutex_t * PluginContext::getAcctMutexRecv(void )
-{
-  return &acctmutexrecv;
-}
-
-
-pthread_t * PluginContext::getThread()
-{
-  return &thread;
+      this->newacctusers.wait();
 }
 
 pthread_t * PluginContext::getAcctThread()
@@ -301,45 +310,23 @@ pthread_t * PluginContext::getAcctThread()
   return &acctthread;
 }
 
-int PluginContext::getResult()
-{
-  return result;
-}
-
-void PluginContext::setResult(int r)
-{ 
-  result=r;
-}
-
-bool PluginContext::UserWaitingtoAuth()
-{
-  bool result;
-
-  pthread_mutex_lock(&usermutex);
-  result = this->newusers.size()>0;
-  pthread_mutex_unlock(&usermutex);
-  return result;
-} 
-
-bool PluginContext::UserWaitingtoAcct()
-{
-  bool result;
-
-  pthread_mutex_lock(&usermutex);
-  result = this->newacctusers.size()>0;
-  pthread_mutex_unlock(&usermutex);
-  return result;
-} 
-
-
 bool PluginContext::getStopThread()
 {
-  return stopthread;
+  return __atomic_load_n(&stopthread, __ATOMIC_ACQUIRE);
 }
 
+/**The method sets the stop flag of the threads, if it is true every
+ * authentication worker and the accounting thread is woken.
+ * @param s The flag.
+ */
 void PluginContext::setStopThread(bool s)
 {
-  stopthread=s;
+  __atomic_store_n(&stopthread, s, __ATOMIC_RELEASE);
+  if (s)
+  {
+    this->newusers.wake(this->authworkers.size());
+    this->newacctusers.wake(1);
+  }
 }
 
 
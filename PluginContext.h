@@ -23,12 +23,17 @@
 #define _CONTEXT_H_
 #include "UserPlugin.h"
 #include "RadiusClass/RadiusConfig.h"
+#include "RadiusClass/RadiusClient.h"
 #include "UserPlugin.h"
 #include "IpcSocket.h"
 #include "Config.h"
+#include "HandoffQueue.h"
+#include "UserMap.h"
+#include "NasPortPool.h"
 #include <sys/types.h>
 #include <list>
 #include <map>
+#include <vector>
 #include <iostream>
 #include <stdlib.h>
 #include <stdio.h>
@@ -41,6 +46,23 @@ using std::list;
 
 using namespace std;
 
+class PluginContext;
+
+/** The class represents an authentication worker of the foreground process. It is a
+ * thread which takes the users from the queue newusers and verifies them with its
+ * own authentication background process, so the workers don't wait for each other.*/
+class AuthWorker
+{
+public:
+	PluginContext	*context;	/**<The context of the plugin.*/
+	IpcSocket		socket;		/**<The socket to the authentication background process of the worker.*/
+	pid_t			pid;		/**<The process id of the authentication background process.*/
+	pthread_t		thread;		/**<The thread of the worker.*/
+	bool			started;	/**<Is true if the thread was started.*/
+	
+	AuthWorker(PluginContext *);
+};
+
 
 /** This class saves all information for the different processes and 
  * it saves the users for the foreground process.*/
@@ -48,51 +70,44 @@ class PluginContext
 {
 private:
 	  	
-  	pid_t authpid; 					/**< Process ID of authentication background process. */
-  	
   	pid_t acctpid; 					/**< Process ID of accounting background process. */
 
   	int verb; 						/**< Verbosity level of OpenVPN. */
   
-  	map<string, UserPlugin *> users; 	/**< The user list of the plugin in for the foreground process which are authenticated.*/
-  	list< UserPlugin *> newusers; 	        /**< The user list of the plugin in for the foreground process which are waiting for authentication.*/
-  	list< UserPlugin *> newacctusers; 	/**< The user list of the plugin in for the foreground process which are waiting for accounting.*/
+  	UserMap users; 	/**< The users of the foreground process which are authenticated, the map holds a reference to every user.*/
+  	HandoffQueue newusers; 	        /**< The queue of the users of the foreground process which are waiting for authentication, every worker is woken for one user.*/
+  	HandoffQueue newacctusers; 	/**< The queue of the users of the foreground process which are waiting for accounting, the thread drains it.*/
 	
-        list <int> nasportlist; 		/**< The port list. Every user gets an unipue port on connect. The number is deleted if the user disconnects, a new user can
-									get the number again. This is important for dynamic IP address assignment via the radius server.*/
+        NasPortPool nasports; 		/**< The free NAS ports. Every user gets an unique port on connect. The port is freed if the user disconnects, a new user can
+									get the port again. This is important for dynamic IP address assignment via the radius server.*/
 	
 	int sessionid; 					/**< Every user gets a new session id. The session is never decremented.*/ 
 
-        pthread_cond_t condsend;
-        pthread_mutex_t mutexsend;
-        pthread_cond_t condrecv;
-        pthread_mutex_t mutexrecv;
-        pthread_t thread; 
-        pthread_cond_t acctcondsend;
-        pthread_mutex_t acctmutexsend;
-        pthread_cond_t acctcondrecv;
-        pthread_mutex_t acctmutexrecv;
         pthread_t acctthread; 
         bool stopthread;
         bool startthread;
-        int result;
 
-        pthread_mutex_t usermutex;
+        pthread_mutex_t usermutex;	/**< The mutex for the nasports.*/
+        
+        pthread_mutex_t loginmutex;	/**< The mutex for the logins of the server groups.*/
+        map<RadiusServerGroup *, list<UserPlugin *> > waitinglogins;	/**< The users which wait for the in-flight limit of their server group.*/
 
 	
 public:
   	
   	IpcSocket 	authsocketforegr; 	/**< Object from the class IpcSocket, it saves the socket to the foregroundprocess from the authentication background process.*/
-  	IpcSocket	authsocketbackgr; 	/**< Object from the class IpcSocket, it saves the socket to the authentication background process.*/ 
+  	vector<AuthWorker *> authworkers;	/**< The authentication workers, every worker has a socket to an own authentication background process.*/ 
   	IpcSocket	acctsocketforegr; 	/**< Object from the class IpcSocket, it saves the socket to the accounting background process.*/	
   	IpcSocket	acctsocketbackgr; 	/**< Object from the class IpcSocket, it saves the socket to the accounting background process-*/	
   	
   	RadiusConfig radiusconf; 		/**< The object saves the radius configuration from the config file.*/
+  	RadiusClient radiusclient;		/**< The object sends the radius packets in the background processes.*/
   	Config		conf;				/**< The object saves the configuration from the config file.*/
   				
 	PluginContext(void);
 	~PluginContext(void);
 	
+	void initNasPorts(int, int);
 	int addNasPort(void);
 	void delNasPort(int );
 	
@@ -100,52 +115,34 @@ public:
 	void addUser(UserPlugin *);
 	void delUser(string );
 	
+	bool startLogin(RadiusServerGroup *, UserPlugin *);
+	UserPlugin * finishLogin(RadiusServerGroup *);
+	
   	
   	int getVerbosity(void);
   	void setVerbosity(int);
   		
   	
-  	pid_t getAuthPid(void); 				
-  	void setAuthPid(pid_t); 
+  	bool hasAuthWorkers(void);
   	
   	pid_t getAcctPid(void); 				
   	void setAcctPid(pid_t); 
   	
   	int getSessionId(void);
   	
-  	pthread_cond_t * getCondSend(void);
-        //void setCond(pthread_cond_t);
-        pthread_cond_t * getCondRecv(void);
-      
-        pthread_mutex_t * getMutexSend(void);
-        pthread_mutex_t * getMutexRecv(void);
-        //void setMutex(pthread_mutex_t);
-
-        pthread_cond_t * getAcctCondSend(void);
-        //void setCond(pthread_cond_t);
-        pthread_cond_t * getAcctCondRecv(void);
-      
-        pthread_mutex_t * getAcctMutexSend(void);
-        pthread_mutex_t * getAcctMutexRecv(void);
-        //void setMutex(pthread_mutex_t);
-        
         UserPlugin * getNewUser();
         UserPlugin * getNewAcctUser();
-        void addNewUser(UserPlugin * newuser);
-        void addNewAcctUser(UserPlugin * newuser);
+        bool addNewUser(UserPlugin * newuser);
+        bool addNewAcctUser(UserPlugin * newuser);
+        void waitNewUser();
+        void waitNewAcctUser();
 
-        pthread_t * getThread();
         pthread_t * getAcctThread();
         
-        int getResult();
-        void setResult(int);
 
         bool getStopThread();
         void setStopThread(bool);
 
-        bool UserWaitingtoAuth();
-        bool UserWaitingtoAcct();
-
         bool getStartThread();
         void setStartThread(bool);
 
@@ -25,8 +25,6 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
-#define NEED_LIBGCRYPT_VERSION "1.2.0"
-GCRY_THREAD_OPTION_PTHREAD_IMPL;
 
 /** The constructor sets the type to 0 and the value to NULL.*/
 RadiusAttribute::RadiusAttribute(void)
@@ -152,95 +150,31 @@ void RadiusAttribute::setLength(Octet len)
  */
 char * RadiusAttribute::makePasswordHash(const char *password,char * hpassword, const char *sharedSecret,const char *authenticator)
 {
+	RadiusCrypto	crypto;
 	
-	unsigned char digest[MD5_DIGEST_LENGTH]; 	//The digest.
-	gcry_md_hd_t context;					//the hash context
-	int i,k,j,l,								//Some counters.
-		passwordlen;							//The password length.
-	
-	memset(digest,0,MD5_DIGEST_LENGTH);
-		
-	//build the hash	
-	if (!gcry_control (GCRYCTL_ANY_INITIALIZATION_P))
-	{ /* No other library has already initialized libgcrypt. */
-
-	  gcry_control(GCRYCTL_SET_THREAD_CBS,&gcry_threads_pthread);
-
-	  if (!gcry_check_version (NEED_LIBGCRYPT_VERSION) )
-	    {
-		cerr << "libgcrypt is too old (need " << NEED_LIBGCRYPT_VERSION << ", have " << gcry_check_version (NULL) << ")\n";
-	    }
-	    /* Disable secure memory.  */
-          gcry_control (GCRYCTL_DISABLE_SECMEM, 0);
-
-	  gcry_control (GCRYCTL_INITIALIZATION_FINISHED);
-	}
+	crypto.setSecret(sharedSecret);
+	return this->makePasswordHash(password, hpassword, &crypto, authenticator);
+}
 
-	gcry_md_open(&context, GCRY_MD_MD5, 0);
-	gcry_md_write(context, sharedSecret, strlen(sharedSecret));
-	gcry_md_write(context, authenticator, MD5_DIGEST_LENGTH);
-	memcpy(digest, gcry_md_read(context, GCRY_MD_MD5), MD5_DIGEST_LENGTH);
-	if (this->length<MD5_DIGEST_LENGTH)
-	{
-		//XOR the password and the digest
-		for(i=0;i<MD5_DIGEST_LENGTH;i++) hpassword[i]=password[i]^digest[i];
-	}
-	else
+/** The method builds the hashed password like makePasswordHash(), but
+ * it uses the saved hash contexts of the shared secret of a server.
+ * @param password The User password.
+ * @param hpassword A char array for the hashed password. It must have the
+ * same length as the password filed (=this->length-2), at least 16 octets.
+ * @param crypto The hash contexts of the shared secret.
+ * @param authenticator String of the authenticator field.
+ * @return A pointer to the hpassword array.
+ */
+char * RadiusAttribute::makePasswordHash(const char *password,char * hpassword, RadiusCrypto *crypto,const char *authenticator)
+{
+	int passwordlen=this->length-2;	//get the length of the passwordfield
+	
+	if (passwordlen<MD5_DIGEST_LENGTH)
 	{
-		passwordlen=this->length-2;	//get the length of the passwordfield
-		
-		//XOR the password and the digest
-		//build the first xOR-hash
-		for(i=0;i<MD5_DIGEST_LENGTH;i++)
-		{
-			hpassword[i]=password[i]^digest[i];
-			
-		}	
-		passwordlen=passwordlen-MD5_DIGEST_LENGTH;	//the next 16 charakters
-		k=0;						//the first loop
-		while (passwordlen>0)
-		{
-			//build the next hash	
-			memset(digest,0,MD5_DIGEST_LENGTH);
-						
-			//put the hash of the last XOR in the digest
-			//build the hash	
-			if (!gcry_control (GCRYCTL_ANY_INITIALIZATION_P))
-			{ /* No other library has already initialized libgcrypt. */
-
-			  gcry_control(GCRYCTL_SET_THREAD_CBS,&gcry_threads_pthread);
-
-			  if (!gcry_check_version (NEED_LIBGCRYPT_VERSION) )
-			    {
-				cerr << "libgcrypt is too old (need " << NEED_LIBGCRYPT_VERSION << ", have " << gcry_check_version (NULL) << ")\n";
-			    }
-			  /* Disable secure memory.  */
-			  gcry_control (GCRYCTL_DISABLE_SECMEM, 0);
-			  gcry_control (GCRYCTL_INITIALIZATION_FINISHED);
-			}
-			gcry_md_open (&context, GCRY_MD_MD5, 0);
-			gcry_md_write(context, sharedSecret, strlen(sharedSecret));
-			gcry_md_write(context, hpassword+(k*MD5_DIGEST_LENGTH), MD5_DIGEST_LENGTH);
-			memcpy(digest, gcry_md_read(context, GCRY_MD_MD5), MD5_DIGEST_LENGTH);
-			
-			
-			j=0;
-			l=i+MD5_DIGEST_LENGTH;
-			for(;i<l;i++)
-			{
-				hpassword[i]=password[i]^digest[j];
-				j++;
-			
-			}
-			passwordlen=passwordlen-MD5_DIGEST_LENGTH;		//and the next 16 characters
-			k++;							//and the next loop
-			
-		}
-		
+		passwordlen=MD5_DIGEST_LENGTH;
 	}
-	gcry_md_close(context);
+	crypto->hidePassword((const Octet *)password, passwordlen, (const Octet *)authenticator, (Octet *)hpassword);
 	return hpassword;
-
 }
 
 
@@ -430,6 +364,17 @@ int RadiusAttribute::setValue(char *value)
 			
 			break;
 		
+		//The value is calculated when the packet is shaped, here
+		//it is only filled with zeros.
+		case ATTRIB_Message_Authenticator:
+			if(!(this->value=new Octet [16]))
+			{
+				return ALLOC_ERROR;
+			}
+			memset(this->value, 0, 16);
+			this->length=16;
+			break;
+		
 		//Special case vender specific, at the moment it is treated as a string.
 		case ATTRIB_Vendor_Specific:
 			if(!(this->value=new Octet [int(value[5])+4]))
@@ -485,7 +430,19 @@ int RadiusAttribute::setRecvValue(char *value)
 
 int RadiusAttribute::intFromBuf(void)
 {
-	return (ntohl(*(int*)this->value));
+	return RadiusAttribute::intFromBuf(this->value);
+}
+
+/** The method transforms 4 octets in network byte order to an integer,
+ * the value doesn't need to be aligned.
+ * @param value A pointer to the value.
+ * @return The transformed integer.
+ */
+int RadiusAttribute::intFromBuf(const Octet *value)
+{
+	uint32_t num;
+	memcpy(&num, value, 4);
+	return (ntohl(num));
 }
 
 /**The overloading of the assignment operator.*/
@@ -542,13 +499,25 @@ int RadiusAttribute::setValue(uint32_t value)
  * @return The ip address as a string.
  */
 string RadiusAttribute::ipFromBuf(void)
+{
+	return RadiusAttribute::ipFromBuf(this->value, this->length-2);
+}
+
+/** The method converts a value in the network format into an ip.
+ * @param value A pointer to the value.
+ * @param len The length of the value.
+ * @return The ip address as a string.
+ */
+string RadiusAttribute::ipFromBuf(const Octet *value, int len)
 {
 	int num,i;
 	char ip2[4],ip3[16];
 	memset(ip3,0,16);
-	for (i=0;i<(this->length-2);i++)
+	if(len>4)
+		len=4;
+	for (i=0;i<len;i++)
 	{
-		num=(int)this->value[i];
+		num=(int)value[i];
 		if(i==0)
 		{
 			sprintf(ip3,"%i",num);
@@ -575,15 +544,24 @@ string RadiusAttribute::ipFromBuf(void)
  */
 string RadiusAttribute::ip6FromBuf(void)
 {
-	int num,i,len;
+	return RadiusAttribute::ip6FromBuf(this->value, this->length-2);
+}
+
+/** The method converts a value in the network format into an IPv6.
+ * @param value A pointer to the value.
+ * @param len The length of the value.
+ * @return The ip address as a string.
+ */
+string RadiusAttribute::ip6FromBuf(const Octet *value, int len)
+{
+	int num,i;
 	char ip2[3],ip3[40];
 	memset(ip3,0,40);
-	len=(this->length-2);
 	if(len>16)
 		len=16;
 	for (i=0;i<len;i++)
 	{
-		num=(int)this->value[i];
+		num=(int)value[i];
 		sprintf(ip2,"%02x",num);
 		strcat(ip3,ip2);
 		if((i%2)==1 && i<len-1)
@@ -24,6 +24,7 @@
 #include <gcrypt.h>
 #include <string>
 #include "radius.h"
+#include "RadiusCrypto.h"
 #include <iostream>
 using namespace std;
 
@@ -69,10 +70,15 @@ public:
 	 
 	string			ipFromBuf(void); 
 	string			ip6FromBuf(void); 
+	
+	static int		intFromBuf(const Octet *value);
+	static string	ipFromBuf(const Octet *value, int len);
+	static string	ip6FromBuf(const Octet *value, int len);
 		
 	void			dumpRadiusAttrib(void);
 	
 	char *			makePasswordHash(const char *password,char * hpassword, const char *sharedSecret, const char *authenticator);
+	char *			makePasswordHash(const char *password,char * hpassword, RadiusCrypto *crypto, const char *authenticator);
 	
 };
 
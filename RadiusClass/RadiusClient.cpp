@@ -0,0 +1,1297 @@
+/*
+ *  RadiusClass -- An C++-Library for radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+#include "RadiusClient.h"
+#include <vector>
+
+using namespace std;
+
+/** The callback of sendRequest(), it saves the result.
+ * @param packet The packet of the request.
+ * @param result The result of the request.
+ * @param arg A pointer to an integer for the result.
+ */
+static void requestDone(RadiusPacket *packet, int result, void *arg)
+{
+	*((int *)arg)=result;
+}
+
+/** The callback of the Status-Server probes, it frees the packet.
+ * The health of the server is updated by the RadiusClient.
+ * @param packet The packet of the request.
+ * @param result The result of the request.
+ * @param arg Not used.
+ */
+static void probeDone(RadiusPacket *packet, int result, void *arg)
+{
+	delete packet;
+}
+
+/** The function sets the deadline of a request to the retransmission
+ * timeout of its server after the time now. After the last transmission
+ * and on streams the server gets the whole wait time, so a slow response is not counted 
+ * as a failure of the server.
+ * @param req The request.
+ * @param now The time when the packet was sent.
+ */
+static void setDeadline(RadiusRequest *req, const struct timeval *now)
+{
+	struct timeval rto;
+	int ms;
+	
+	if (req->retries>=req->server->getRetry() || req->server->getTransport()!=RADIUS_TRANSPORT_UDP)
+	{
+		ms=req->server->getWait()*1000;
+	}
+	else
+	{
+		ms=req->server->getRto(req->retries-1);
+	}
+	rto.tv_sec=ms/1000;
+	rto.tv_usec=(ms%1000)*1000;
+	timeradd(now, &rto, &req->deadline);
+}
+
+/** The function sets the time when an Access-Request is hedged. It is
+ * the latency percentile of the group after the packet was sent to the server. 
+ * A request is hedged only once and only if there are enough samples of 
+ * the round trip time of the server.
+ * @param req The request.
+ */
+static void setHedgeTime(RadiusRequest *req)
+{
+	struct timeval lat;
+	int us=0;
+	
+	timerclear(&req->hedgetime);
+	if (req->group==NULL || req->hedge || req->twin!=NULL || req->group->getHedgePercentile()==0 ||
+		req->packet->getCode()!=ACCESS_REQUEST || req->serverlist->size()<2)
+	{
+		return;
+	}
+	if ((us=req->server->getLatency(req->group->getHedgePercentile()))>0)
+	{
+		lat.tv_sec=us/1000000;
+		lat.tv_usec=us%1000000;
+		timeradd(&req->sent, &lat, &req->hedgetime);
+	}
+}
+
+/** The function checks if the other side has closed a stream socket,
+ * e.g. because it was idle.
+ * @param sock The socket.
+ * @return True if the stream is closed or broken.
+ */
+static bool streamClosed(int sock)
+{
+	char c;
+	int n;
+	
+	n=recv(sock, &c, 1, MSG_PEEK|MSG_DONTWAIT);
+	return (n==0 || (n<0 && errno!=EAGAIN && errno!=EWOULDBLOCK && errno!=EINTR));
+}
+
+/** The constructor of the class. The epoll descriptor is
+ * created on the first request, so an unused object needs no resources.
+ */
+RadiusClient::RadiusClient(void)
+{
+	this->epollfd=-1;
+	this->outstanding=0;
+	this->batching=false;
+}
+
+/** The destructor of the class. It closes the epoll descriptor
+ * and frees the requests which are not finished, the callbacks
+ * are not called.
+ */
+RadiusClient::~RadiusClient(void)
+{
+	map<int, RadiusInFlight>::iterator it;
+	int i;
+	
+	for (it=this->inflight.begin(); it!=this->inflight.end(); it++)
+	{
+		for (i=0; i<RADIUS_MAX_INFLIGHT; i++)
+		{
+			if (it->second.slot[i]!=NULL)
+			{
+				this->freeRequest(it->second.slot[i]);
+			}
+		}
+	}
+	while (!this->pending.empty())
+	{
+		this->freeRequest(this->pending.front());
+		this->pending.pop_front();
+	}
+	while (!this->limited.empty())
+	{
+		this->freeRequest(this->limited.front());
+		this->limited.pop_front();
+	}
+	if (this->epollfd>=0)
+	{
+		close(this->epollfd);
+	}
+}
+
+/** The method submits a packet. The packet is sent to the first server
+ * of the list, if the server doesn't answer the packet is sent to the next
+ * server. Servers which are marked as dead are skipped, if all servers are dead
+ * they are tried anyway. The method doesn't wait for the response, the responses are
+ * received in poll(). The packet must exist until the callback is called.
+ * If the packet can't be sent to any server the callback is called before 
+ * the method returns.
+ * @param packet The packet to send.
+ * @param serverlist The list of the servers.
+ * @param callback The function which is called when the request is finished.
+ * @param arg The argument for the callback.
+ * @return 0 if the request was submitted, NO_RESPONSE if the list is empty or 
+ * SOCKET_ERROR.
+ */
+int RadiusClient::submit(RadiusPacket *packet, list<RadiusServer> *serverlist, RadiusCallback callback, void *arg)
+{
+	return this->submitRequest(packet, serverlist, NULL, serverlist->begin(), callback, arg);
+}
+
+/** The method submits a packet like the method above, but the first
+ * server is selected by the balancing policy of the group. For the consistent 
+ * hashing the User-Name of the packet is the key.
+ * @param packet The packet to send.
+ * @param group The server group.
+ * @param callback The function which is called when the request is finished.
+ * @param arg The argument for the callback.
+ * @return 0 if the request was submitted, NO_RESPONSE if the group is empty or 
+ * SOCKET_ERROR.
+ */
+int RadiusClient::submit(RadiusPacket *packet, RadiusServerGroup *group, RadiusCallback callback, void *arg)
+{
+	pair<multimap<Octet,RadiusAttribute>::iterator,multimap<Octet,RadiusAttribute>::iterator> range;
+	string key;
+	const Octet *value;
+	int len;
+	
+	if (group->getPolicy()==BALANCE_HASH)
+	{
+		range=packet->findAttributes(ATTRIB_User_Name);
+		if (range.first!=range.second)
+		{
+			key.assign((char *)range.first->second.getValue(), range.first->second.getLength()-2);
+		}
+		else if ((len=packet->findAttribute(ATTRIB_User_Name, &value))>0)
+		{
+			key.assign((const char *)value, len);
+		}
+	}
+	
+	return this->submitRequest(packet, group->getServers(), group, group->selectServer(key), callback, arg);
+}
+
+/** The method creates the request for submit() and starts it.
+ * @param packet The packet to send.
+ * @param serverlist The list of the servers.
+ * @param group The group of the servers, it is NULL if there is no group.
+ * @param server The first server.
+ * @param callback The function which is called when the request is finished.
+ * @param arg The argument for the callback.
+ * @return 0 if the request was submitted, NO_RESPONSE if the list is empty or 
+ * SOCKET_ERROR.
+ */
+int RadiusClient::submitRequest(RadiusPacket *packet, list<RadiusServer> *serverlist, RadiusServerGroup *group, list<RadiusServer>::iterator server, RadiusCallback callback, void *arg)
+{
+	RadiusRequest *req;
+	
+	if (serverlist->empty())
+	{
+		return NO_RESPONSE;
+	}
+	if (this->epollfd<0 && (this->epollfd=epoll_create1(EPOLL_CLOEXEC))<0)
+	{
+		cerr << "Cannot create epoll descriptor: " << strerror(errno) << "\n";
+		return SOCKET_ERROR;
+	}
+	
+	//probe the dead servers of the list
+	this->probeServers(serverlist, packet->getCode()==ACCOUNTING_REQUEST);
+	
+	req=new RadiusRequest;
+	req->packet=packet;
+	req->serverlist=serverlist;
+	req->server=server;
+	req->tried=0;
+	req->retries=0;
+	req->sock=-1;
+	req->result=NO_RESPONSE;
+	req->attempts=0;
+	req->ignorehealth=false;
+	req->probe=false;
+	req->acct=(packet->getCode()==ACCOUNTING_REQUEST);
+	req->group=group;
+	req->twin=NULL;
+	req->hedge=false;
+	req->waiting=false;
+	timerclear(&req->hedgetime);
+	req->callback=callback;
+	req->arg=arg;
+	this->outstanding++;
+	if (group!=NULL && !group->takeInFlight())
+	{
+		this->limited.push_back(req);
+		return 0;
+	}
+	this->startRequest(req);
+	return 0;
+}
+
+/** The method sends the packet of a request to the current server
+ * of the request. The packet gets a free identifier of the socket of the server.
+ * If there is no free identifier the request waits in the pending list. If the
+ * packet can't be sent, the next server is tried. If there is no server
+ * left, the request is finished.
+ * @param req The request.
+ * @return 0 if the packet was sent or is pending, else the error of the request.
+ */
+int RadiusClient::startRequest(RadiusRequest *req)
+{
+	int sock, id, result;
+	RadiusInFlight *table;
+	struct epoll_event ev;
+	bool delay;
+	
+	while (req->tried < (int) req->serverlist->size() || (req->attempts==0 && !req->ignorehealth))
+	{
+		//all servers are dead, try them anyway
+		if (req->tried >= (int) req->serverlist->size())
+		{
+			req->ignorehealth=true;
+			req->tried=0;
+			req->server=req->serverlist->begin();
+		}
+		if (!req->ignorehealth && !req->server->isAlive())
+		{
+			this->nextServer(req);
+			continue;
+		}
+		
+		//the sockets to an old address of the server are closed first,
+		//the next socket can get the same number
+		this->closeStaleSockets(&(*req->server));
+		if (req->acct)
+		{
+			sock=req->server->getAcctSocket();
+		}
+		else
+		{
+			sock=req->server->getAuthSocket();
+		}
+		if (sock<0)
+		{
+			req->result=sock;
+			req->attempts++;
+			req->server->markFailure();
+			this->nextServer(req);
+			continue;
+		}
+		
+		//a stream which was used before may be closed by the server,
+		//a new stream gets an empty buffer
+		if (req->server->getTransport()!=RADIUS_TRANSPORT_UDP)
+		{
+			if (this->streams.find(sock)!=this->streams.end())
+			{
+				if (!this->streams[sock].connecting && streamClosed(sock))
+				{
+					this->closeStream(sock, &(*req->server));
+					continue;
+				}
+			}
+			else
+			{
+				//the stream is watched for the end of the connect
+				this->streams[sock].server=&(*req->server);
+				this->streams[sock].connecting=true;
+				this->streams[sock].events=0;
+				this->streams[sock].len=0;
+				if (this->watchStream(sock, &this->streams[sock])<0)
+				{
+					this->closeStream(sock, &(*req->server));
+					req->result=SOCKET_ERROR;
+					req->attempts++;
+					req->server->markFailure();
+					this->nextServer(req);
+					continue;
+				}
+			}
+		}
+		
+		//create the table of the socket, the identifiers
+		//start at the random identifier of the packet
+		if (this->inflight.find(sock)==this->inflight.end())
+		{
+			table=&(this->inflight[sock]);
+			memset(table->slot, 0, sizeof(table->slot));
+			table->count=0;
+			table->next=req->packet->getIdentifier();
+		}
+		table=&(this->inflight[sock]);
+		
+		if (table->count>=RADIUS_MAX_INFLIGHT)
+		{
+			req->sock=-1;
+			this->pending.push_back(req);
+			return 0;
+		}
+		
+		//watch the socket, if it is in use again
+		if (table->count==0)
+		{
+			ev.events=EPOLLIN;
+			ev.data.fd=sock;
+			if (epoll_ctl(this->epollfd, EPOLL_CTL_ADD, sock, &ev)<0 && errno!=EEXIST)
+			{
+				req->result=SOCKET_ERROR;
+				this->nextServer(req);
+				continue;
+			}
+		}
+		
+		//find a free identifier
+		for (id=table->next; table->slot[id]!=NULL; id=(id+1)%RADIUS_MAX_INFLIGHT);
+		table->next=(id+1)%RADIUS_MAX_INFLIGHT;
+		table->slot[id]=req;
+		table->count++;
+		req->server->incOutstanding();
+		req->sock=sock;
+		req->retries=1;
+		req->attempts++;
+		req->packet->setIdentifier(id);
+		
+		//in a batch the Accounting-Request is signed and sent by sendBatch()
+		delay=this->batching && req->packet->getCode()==ACCOUNTING_REQUEST;
+		if (req->packet->radiusShape(&(*req->server), sock, !delay)<0 || (!delay && this->transmit(req)<0))
+		{
+			this->releaseSlot(req);
+			if (req->server->getTransport()!=RADIUS_TRANSPORT_UDP)
+			{
+				this->closeStream(sock, &(*req->server));
+			}
+			req->result=SOCKET_ERROR;
+			req->server->markFailure();
+			this->nextServer(req);
+			continue;
+		}
+		if (delay)
+		{
+			this->batch.push_back(req);
+			return 0;
+		}
+		gettimeofday(&req->sent, NULL);
+		setDeadline(req, &req->sent);
+		setHedgeTime(req);
+		return 0;
+	}
+	result=req->result;
+	this->finishRequest(req, result);
+	return result;
+}
+
+/** The method starts a batch. The Accounting-Requests which are submitted
+ * until sendBatch() are shaped, but not sent. sendBatch() signs them together
+ * with RadiusPacket::signAccounting(), which hashes more packets at the same time.
+ */
+void RadiusClient::startBatch(void)
+{
+	this->batching=true;
+}
+
+/** The method signs and sends the Accounting-Requests of the batch and ends
+ * the batch. If a packet can't be sent, the next server is tried after all 
+ * packets are sent. poll() calls the method, too.
+ */
+void RadiusClient::sendBatch(void)
+{
+	list<RadiusRequest *> reqs, failed;
+	list<RadiusRequest *>::iterator it;
+	vector<RadiusPacket *> packets;
+	RadiusRequest *req;
+	
+	this->batching=false;
+	if (this->batch.empty())
+	{
+		return;
+	}
+	reqs.swap(this->batch);
+	for (it=reqs.begin(); it!=reqs.end(); it++)
+	{
+		packets.push_back((*it)->packet);
+	}
+	RadiusPacket::signAccounting(&packets[0], packets.size());
+	
+	for (it=reqs.begin(); it!=reqs.end(); it++)
+	{
+		req=*it;
+		if (this->transmit(req)<0)
+		{
+			//a closed stream is found by the next request or by epoll
+			this->releaseSlot(req);
+			req->result=SOCKET_ERROR;
+			req->server->markFailure();
+			failed.push_back(req);
+			continue;
+		}
+		gettimeofday(&req->sent, NULL);
+		setDeadline(req, &req->sent);
+		setHedgeTime(req);
+	}
+	
+	for (it=failed.begin(); it!=failed.end(); it++)
+	{
+		this->nextServer(*it);
+		this->startRequest(*it);
+	}
+}
+
+/** The method sets the next server of the list as the current 
+ * server of the request.
+ * @param req The request.
+ */
+void RadiusClient::nextServer(RadiusRequest *req)
+{
+	req->tried++;
+	req->server++;
+	if (req->server==req->serverlist->end())
+	{
+		req->server=req->serverlist->begin();
+	}
+}
+
+/** The method is called if the current server of the request didn't
+ * answer. The failure is counted for the health of the server and the
+ * packet is sent to the next server.
+ * @param req The request.
+ */
+void RadiusClient::failServer(RadiusRequest *req)
+{
+	req->server->markFailure();
+	this->releaseSlot(req);
+	this->nextServer(req);
+	this->startRequest(req);
+}
+
+/** The method frees the identifier of the request in the in-flight
+ * table of its socket.
+ * @param req The request.
+ */
+void RadiusClient::releaseSlot(RadiusRequest *req)
+{
+	map<int, RadiusInFlight>::iterator it;
+	
+	if (req->sock<0)
+	{
+		return;
+	}
+	it=this->inflight.find(req->sock);
+	if (it!=this->inflight.end() && it->second.slot[req->packet->getIdentifier()]==req)
+	{
+		it->second.slot[req->packet->getIdentifier()]=NULL;
+		it->second.count--;
+		req->server->decOutstanding();
+	}
+	req->sock=-1;
+}
+
+/** The method finishes a request, the callback is called and the
+ * request is freed. If the request was hedged, the first response is taken: 
+ * if the hedged copy gets it, the response is moved to the original request, else
+ * the copy is canceled. If one of both fails, the other one is waited for.
+ * @param req The request.
+ * @param result The result for the callback.
+ */
+void RadiusClient::finishRequest(RadiusRequest *req, int result)
+{
+	RadiusRequest *twin=req->twin;
+	
+	if (req->hedge)
+	{
+		twin->twin=NULL;
+		if (result==0)
+		{
+			//the original request is not sent any longer
+			this->pending.remove(twin);
+			this->releaseSlot(twin);
+			twin->packet->takeResponse(req->packet);
+		}
+		delete req->packet;
+		delete req;
+		if (result==0)
+		{
+			this->finishRequest(twin, 0);
+		}
+		else if (twin->waiting)
+		{
+			this->finishRequest(twin, twin->result);
+		}
+		return;
+	}
+	if (twin!=NULL)
+	{
+		if (result!=0)
+		{
+			//wait for the response to the hedged copy
+			req->result=result;
+			req->waiting=true;
+			return;
+		}
+		this->pending.remove(twin);
+		this->releaseSlot(twin);
+		delete twin->packet;
+		delete twin;
+	}
+	
+	this->outstanding--;
+	if (req->probe)
+	{
+		req->server->setProbing(false);
+	}
+	if (req->callback)
+	{
+		req->callback(req->packet, result, req->arg);
+	}
+	if (req->group!=NULL)
+	{
+		req->group->releaseInFlight();
+		this->startLimited(req->group);
+	}
+	delete req;
+}
+
+/** The method starts the first request which waits for the in-flight 
+ * limit of the group.
+ * @param group The group.
+ */
+void RadiusClient::startLimited(RadiusServerGroup *group)
+{
+	list<RadiusRequest *>::iterator it;
+	RadiusRequest *req;
+	
+	for (it=this->limited.begin(); it!=this->limited.end(); it++)
+	{
+		if ((*it)->group==group)
+		{
+			if (!group->takeInFlight())
+			{
+				return;
+			}
+			req=*it;
+			this->limited.erase(it);
+			this->startRequest(req);
+			return;
+		}
+	}
+}
+
+/** The method frees a request without calling the callback. The packet 
+ * of a hedged copy belongs to the request and is freed, too.
+ * @param req The request.
+ */
+void RadiusClient::freeRequest(RadiusRequest *req)
+{
+	if (req->hedge)
+	{
+		if (req->twin!=NULL && req->twin->waiting)
+		{
+			delete req->twin;
+		}
+		else if (req->twin!=NULL)
+		{
+			req->twin->twin=NULL;
+		}
+		delete req->packet;
+	}
+	else if (req->twin!=NULL)
+	{
+		req->twin->twin=NULL;
+	}
+	delete req;
+}
+
+/** The method sends a copy of an Access-Request to the next server, if
+ * the budget of the group allows it. The copy gets its own identifier and 
+ * authenticator, it is failed over like the original request, but it 
+ * doesn't go back to the server of the original request.
+ * @param req The request.
+ */
+void RadiusClient::startHedge(RadiusRequest *req)
+{
+	RadiusRequest *copy;
+	
+	timerclear(&req->hedgetime);
+	if (!req->group->takeHedge())
+	{
+		return;
+	}
+	copy=new RadiusRequest;
+	copy->packet=new RadiusPacket(*req->packet);
+	copy->serverlist=req->serverlist;
+	copy->server=req->server;
+	copy->tried=0;
+	copy->retries=0;
+	copy->sock=-1;
+	copy->result=NO_RESPONSE;
+	//the server of the original request is not tried
+	copy->attempts=1;
+	copy->ignorehealth=false;
+	copy->probe=false;
+	copy->acct=req->acct;
+	copy->group=req->group;
+	copy->twin=req;
+	copy->hedge=true;
+	copy->waiting=false;
+	timerclear(&copy->hedgetime);
+	copy->callback=NULL;
+	copy->arg=NULL;
+	req->twin=copy;
+	this->nextServer(copy);
+	copy->tried=1;
+	this->startRequest(copy);
+}
+
+/** The method sends the shaped packet of a request. On a stream the packet
+ * is queued, if the connect is not finished or the stream is not writable, 
+ * writeStream() sends it later.
+ * @param req The request.
+ * @return The length of the packet or SOCKET_ERROR.
+ */
+int RadiusClient::transmit(RadiusRequest *req)
+{
+	map<int, RadiusStream>::iterator st;
+	RadiusStream *stream;
+	const Octet *buf;
+	int len, sent=0;
+	
+	if ((st=this->streams.find(req->sock))==this->streams.end())
+	{
+		return req->packet->radiusTransmit();
+	}
+	stream=&st->second;
+	if ((len=req->packet->getSendBuffer(&buf))<0)
+	{
+		return len;
+	}
+	
+	//the order of the bytes on the stream must be kept
+	if (!stream->connecting && stream->out.empty())
+	{
+		while ((sent=send(req->sock, buf, len, MSG_NOSIGNAL|MSG_DONTWAIT))<0 && errno==EINTR);
+		if (sent<0 && errno!=EAGAIN && errno!=EWOULDBLOCK)
+		{
+			return SOCKET_ERROR;
+		}
+		if (sent<0)
+		{
+			sent=0;
+		}
+	}
+	if (sent<len)
+	{
+		stream->out.insert(stream->out.end(), buf+sent, buf+len);
+		if (this->watchStream(req->sock, stream)<0)
+		{
+			return SOCKET_ERROR;
+		}
+	}
+	return len;
+}
+
+/** The method sets the epoll events of a stream. It is watched for writing
+ * until the connect is finished and the queued bytes are written.
+ * @param sock The socket.
+ * @param stream The buffers of the stream.
+ * @return 0 or -1 in case of error.
+ */
+int RadiusClient::watchStream(int sock, RadiusStream *stream)
+{
+	struct epoll_event ev;
+	
+	ev.events=EPOLLIN;
+	if (stream->connecting || !stream->out.empty())
+	{
+		ev.events|=EPOLLOUT;
+	}
+	ev.data.fd=sock;
+	if ((int)ev.events==stream->events)
+	{
+		return 0;
+	}
+	if (epoll_ctl(this->epollfd, stream->events==0?EPOLL_CTL_ADD:EPOLL_CTL_MOD, sock, &ev)<0)
+	{
+		return -1;
+	}
+	stream->events=ev.events;
+	return 0;
+}
+
+/** The method is called if a stream is writable or has an error. It
+ * checks the result of the connect and writes the queued bytes. If the connect
+ * failed or the stream is broken, the stream is closed and its requests 
+ * are sent to the next server.
+ * @param sock The socket.
+ * @param stream The buffers of the stream.
+ * @return True if the stream is still open.
+ */
+bool RadiusClient::writeStream(int sock, RadiusStream *stream)
+{
+	struct sockaddr_storage addr;
+	socklen_t len;
+	int err=0, sent;
+	
+	if (stream->connecting)
+	{
+		len=sizeof(err);
+		if (getsockopt(sock, SOL_SOCKET, SO_ERROR, &err, &len)<0)
+		{
+			err=errno;
+		}
+		//the event may belong to a closed socket with the same number
+		len=sizeof(addr);
+		if (err==0 && getpeername(sock, (struct sockaddr *)&addr, &len)<0 && errno==ENOTCONN)
+		{
+			return true;
+		}
+		if (err!=0)
+		{
+			cerr << "Cannot connect socket to " << stream->server->getName() << ": " << strerror(err) << "\n";
+			this->closeStream(sock, stream->server);
+			return false;
+		}
+		stream->connecting=false;
+	}
+	
+	while (!stream->out.empty())
+	{
+		if ((sent=send(sock, &stream->out[0], stream->out.size(), MSG_NOSIGNAL|MSG_DONTWAIT))<0)
+		{
+			if (errno==EINTR)
+			{
+				continue;
+			}
+			if (errno==EAGAIN || errno==EWOULDBLOCK)
+			{
+				break;
+			}
+			this->closeStream(sock, stream->server);
+			return false;
+		}
+		stream->out.erase(stream->out.begin(), stream->out.begin()+sent);
+	}
+	if (this->watchStream(sock, stream)<0)
+	{
+		this->closeStream(sock, stream->server);
+		return false;
+	}
+	return true;
+}
+
+/** The method reads all datagrams which are waiting on the socket. 
+ * The request is found by the identifier of the datagram. Datagrams without
+ * a request or with a wrong authenticator are dropped. If the server sent
+ * an ICMP port unreachable, all requests on the socket are sent to the next server.
+ * @param sock The socket.
+ */
+void RadiusClient::readSocket(int sock)
+{
+	map<int, RadiusInFlight>::iterator it;
+	map<int, RadiusStream>::iterator st;
+	vector<RadiusRequest *> failed;
+	int len, i;
+	
+	if ((st=this->streams.find(sock))!=this->streams.end())
+	{
+		this->readStream(sock, &st->second);
+		return;
+	}
+	
+	while ((len=recv(sock, this->buffer, RADIUS_MAX_PACKET_LEN, MSG_DONTWAIT))>=0 || errno==EINTR)
+	{
+		if (len>0)
+		{
+			this->receivePacket(sock, this->buffer, len);
+		}
+	}
+	
+	if (errno==ECONNREFUSED && (it=this->inflight.find(sock))!=this->inflight.end())
+	{
+		for (i=0; i<RADIUS_MAX_INFLIGHT; i++)
+		{
+			if (it->second.slot[i]!=NULL)
+			{
+				failed.push_back(it->second.slot[i]);
+			}
+		}
+		for (i=0; i<(int)failed.size(); i++)
+		{
+			this->failServer(failed[i]);
+		}
+	}
+}
+
+/** The method reads the bytes which are waiting on a stream socket.
+ * The complete packets are taken from the buffer and handled like datagrams.
+ * If the stream is closed or a packet has a wrong length, the stream 
+ * is closed and its requests are sent to the next server.
+ * @param sock The socket.
+ * @param stream The buffer of the stream.
+ */
+void RadiusClient::readStream(int sock, RadiusStream *stream)
+{
+	vector< vector<Octet> > packets;
+	RadiusServer *server=stream->server;
+	int len, plen=RADIUS_MAX_PACKET_LEN, i;
+	bool broken;
+	
+	while ((len=recv(sock, stream->buffer+stream->len, RADIUS_MAX_PACKET_LEN-stream->len, MSG_DONTWAIT))!=0)
+	{
+		if (len<0 && errno==EINTR)
+		{
+			continue;
+		}
+		if (len<0)
+		{
+			break;
+		}
+		stream->len+=len;
+		
+		//take the complete packets
+		while (stream->len>=4 && stream->len>=(plen=(stream->buffer[2]<<8)|stream->buffer[3]))
+		{
+			if (plen<20)
+			{
+				break;
+			}
+			packets.push_back(vector<Octet>(stream->buffer, stream->buffer+plen));
+			stream->len-=plen;
+			memmove(stream->buffer, stream->buffer+plen, stream->len);
+		}
+		if (stream->len>=4 && plen<20)
+		{
+			break;
+		}
+	}
+	
+	//the stream must be closed on the end of the stream, an error or
+	//if the framing is lost. The server gets a new stream for the next 
+	//packets, but the received packets are handled before.
+	broken=(len==0 || (len<0 && errno!=EAGAIN && errno!=EWOULDBLOCK) || (stream->len>=4 && plen<20));
+	if (broken)
+	{
+		server->releaseSocket(sock);
+	}
+	for (i=0; i<(int)packets.size(); i++)
+	{
+		this->receivePacket(sock, &packets[i][0], packets[i].size());
+	}
+	if (broken)
+	{
+		this->closeStream(sock, server);
+	}
+}
+
+/** The method handles a received packet. The request is found by the 
+ * identifier of the packet. Packets without a request or with a wrong 
+ * authenticator are dropped.
+ * @param sock The socket of the packet.
+ * @param buf The packet.
+ * @param len The length of the packet.
+ */
+void RadiusClient::receivePacket(int sock, const Octet *buf, int len)
+{
+	map<int, RadiusInFlight>::iterator it;
+	RadiusRequest *req;
+	struct timeval now, diff;
+	int result;
+	
+	if (len<20 || (it=this->inflight.find(sock))==this->inflight.end())
+	{
+		return;
+	}
+	if ((req=it->second.slot[buf[1]])==NULL)
+	{
+		return;
+	}
+	result=req->packet->radiusParseResponse(buf, len);
+	if (result==WRONG_AUTHENTICATOR_IN_RECV_PACKET || result==BAD_LENGTH)
+	{
+		req->result=WRONG_AUTHENTICATOR_IN_RECV_PACKET;
+		return;
+	}
+	//only a response to a packet which was not retransmitted 
+	//is a valid sample of the round trip time
+	if (req->retries==1)
+	{
+		gettimeofday(&now, NULL);
+		timersub(&now, &req->sent, &diff);
+		req->server->updateRtt(diff.tv_sec*1000000+diff.tv_usec);
+	}
+	req->server->markResponse();
+	this->releaseSlot(req);
+	this->finishRequest(req, result);
+}
+
+/** The method closes a stream socket of a server or a stale socket. The requests on
+ * the socket are sent to the next server, the in-flight table and the buffers of 
+ * the socket are freed. It is counted as one failure of the server.
+ * @param sock The socket.
+ * @param server The server of the socket.
+ * @param restart If it is true the requests are sent to the same server again on a
+ * new socket, the server didn't fail (e.g. its address has changed).
+ */
+void RadiusClient::closeStream(int sock, RadiusServer *server, bool restart)
+{
+	map<int, RadiusInFlight>::iterator it;
+	vector<RadiusRequest *> failed;
+	int i;
+	
+	if ((it=this->inflight.find(sock))!=this->inflight.end())
+	{
+		for (i=0; i<RADIUS_MAX_INFLIGHT; i++)
+		{
+			if (it->second.slot[i]!=NULL)
+			{
+				failed.push_back(it->second.slot[i]);
+				this->releaseSlot(it->second.slot[i]);
+			}
+		}
+		this->inflight.erase(it);
+	}
+	this->streams.erase(sock);
+	server->releaseSocket(sock);
+	close(sock);
+	
+	//a broken stream or a failed connect is one failure of the server
+	if (!restart && !failed.empty())
+	{
+		server->markFailure();
+	}
+	for (i=0; i<(int)failed.size(); i++)
+	{
+		if (!restart)
+		{
+			this->nextServer(failed[i]);
+		}
+		this->startRequest(failed[i]);
+	}
+}
+
+/** The method closes the stale sockets of a server, see RadiusServer::takeStaleSocket().
+ * @param server The server.
+ */
+void RadiusClient::closeStaleSockets(RadiusServer *server)
+{
+	int sock;
+	
+	while ((sock=server->takeStaleSocket())>=0)
+	{
+		this->closeStream(sock, server, true);
+	}
+}
+
+/** The method sends the packets of the requests again, if there was no 
+ * response in the wait time of the server. If the packet was sent retry times,
+ * it is counted as a failure of the server and the packet is sent to the next server.
+ * The timeout is doubled for every retransmission, packets on streams 
+ * are not sent again, a stream which is still not connected is closed. Access-Requests which
+ * are not answered at their hedge time are sent to the next server, too.
+ */
+void RadiusClient::checkTimeouts(void)
+{
+	map<int, RadiusInFlight>::iterator it;
+	map<int, RadiusStream>::iterator st;
+	vector< pair<int, RadiusServer *> > unconnected;
+	vector<RadiusRequest *> expired, hedged;
+	RadiusRequest *req;
+	struct timeval now;
+	int i;
+	
+	gettimeofday(&now, NULL);
+	
+	//a stream which is not connected until a request on it expires is
+	//closed, all its requests are sent to the next server
+	for (st=this->streams.begin(); st!=this->streams.end(); st++)
+	{
+		if (!st->second.connecting || (it=this->inflight.find(st->first))==this->inflight.end())
+		{
+			continue;
+		}
+		for (i=0; i<RADIUS_MAX_INFLIGHT && it->second.count>0; i++)
+		{
+			if (it->second.slot[i]!=NULL && !timercmp(&now, &it->second.slot[i]->deadline, <))
+			{
+				unconnected.push_back(make_pair(st->first, st->second.server));
+				break;
+			}
+		}
+	}
+	for (i=0; i<(int)unconnected.size(); i++)
+	{
+		cerr << "Cannot connect socket to " << unconnected[i].second->getName() << ": " << strerror(ETIMEDOUT) << "\n";
+		this->closeStream(unconnected[i].first, unconnected[i].second);
+	}
+	
+	for (it=this->inflight.begin(); it!=this->inflight.end(); it++)
+	{
+		for (i=0; i<RADIUS_MAX_INFLIGHT && it->second.count>0; i++)
+		{
+			req=it->second.slot[i];
+			if (req!=NULL && !timercmp(&now, &req->deadline, <))
+			{
+				expired.push_back(req);
+			}
+			if (req!=NULL && timerisset(&req->hedgetime) && !timercmp(&now, &req->hedgetime, <))
+			{
+				hedged.push_back(req);
+			}
+		}
+	}
+	
+	//the hedged copies are started first, the failover 
+	//of the expired requests may finish a request
+	for (i=0; i<(int)hedged.size(); i++)
+	{
+		this->startHedge(hedged[i]);
+	}
+	for (i=0; i<(int)expired.size(); i++)
+	{
+		req=expired[i];
+		if (req->retries < req->server->getRetry() && req->server->getTransport()==RADIUS_TRANSPORT_UDP &&
+			req->packet->radiusTransmit()>=0)
+		{
+			req->retries++;
+			setDeadline(req, &now);
+		}
+		else
+		{
+			this->failServer(req);
+		}
+	}
+}
+
+/** The method calculates the time until the next request must be sent again
+ * or hedged.
+ * @param timeout The maximum time in milliseconds, -1 means no maximum.
+ * @return The time in milliseconds.
+ */
+int RadiusClient::getTimeout(int timeout)
+{
+	map<int, RadiusInFlight>::iterator it;
+	struct timeval now, next, diff;
+	bool found=false;
+	int i, ms;
+	
+	for (it=this->inflight.begin(); it!=this->inflight.end(); it++)
+	{
+		for (i=0; i<RADIUS_MAX_INFLIGHT && it->second.count>0; i++)
+		{
+			if (it->second.slot[i]==NULL)
+			{
+				continue;
+			}
+			if (!found || timercmp(&it->second.slot[i]->deadline, &next, <))
+			{
+				next=it->second.slot[i]->deadline;
+				found=true;
+			}
+			if (timerisset(&it->second.slot[i]->hedgetime) && timercmp(&it->second.slot[i]->hedgetime, &next, <))
+			{
+				next=it->second.slot[i]->hedgetime;
+			}
+		}
+	}
+	if (!found)
+	{
+		return timeout;
+	}
+	gettimeofday(&now, NULL);
+	if (!timercmp(&now, &next, <))
+	{
+		return 0;
+	}
+	timersub(&next, &now, &diff);
+	ms=diff.tv_sec*1000+(diff.tv_usec+999)/1000;
+	if (timeout>=0 && timeout<ms)
+	{
+		return timeout;
+	}
+	return ms;
+}
+
+/** The method waits for responses and handles the timeouts 
+ * of the requests. The callbacks of the finished requests are called.
+ * @param timeout The maximum time to wait in milliseconds, -1 waits until
+ * the next request must be sent again.
+ * @return The number of requests which are not finished.
+ */
+int RadiusClient::poll(int timeout)
+{
+	struct epoll_event events[32];
+	map<int, RadiusStream>::iterator st;
+	list<RadiusRequest *> waiting;
+	int n, i;
+	
+	this->sendBatch();
+	if (this->outstanding==0)
+	{
+		return 0;
+	}
+	
+	n=epoll_wait(this->epollfd, events, 32, this->getTimeout(timeout));
+	for (i=0; i<n; i++)
+	{
+		//a stream which is closed after the connect failed isn't read
+		if ((events[i].events&(EPOLLOUT|EPOLLERR|EPOLLHUP)) && 
+			(st=this->streams.find(events[i].data.fd))!=this->streams.end() &&
+			!this->writeStream(events[i].data.fd, &st->second))
+		{
+			continue;
+		}
+		this->readSocket(events[i].data.fd);
+	}
+	this->checkTimeouts();
+	
+	//start the requests which wait for a free identifier
+	waiting.swap(this->pending);
+	while (!waiting.empty())
+	{
+		this->startRequest(waiting.front());
+		waiting.pop_front();
+	}
+	return this->outstanding;
+}
+
+/** The method waits until all requests are finished.
+ */
+void RadiusClient::run(void)
+{
+	while (this->poll(-1)>0);
+}
+
+/** The method sends a packet and waits for the response. Other
+ * requests are handled in the meantime.
+ * @param packet The packet to send.
+ * @param serverlist The list of the servers.
+ * @return 0 if a response was received, else NO_RESPONSE, 
+ * WRONG_AUTHENTICATOR_IN_RECV_PACKET, UNSHAPE_ERROR, UNKNOWN_HOST or SOCKET_ERROR.
+ */
+int RadiusClient::sendRequest(RadiusPacket *packet, list<RadiusServer> *serverlist)
+{
+	//the results are 0 or negative
+	int result=1, ret;
+	
+	if ((ret=this->submit(packet, serverlist, requestDone, &result))!=0)
+	{
+		return ret;
+	}
+	while (result==1)
+	{
+		this->poll(-1);
+	}
+	return result;
+}
+
+/** The method sends Status-Server packets (RFC 5997) to the dead servers of the 
+ * list, which should be probed and whose dead time is over. The probe is sent
+ * to the authentication or the accounting port, if it is answered the server is alive again.
+ * Else the server stays dead for a longer time and is probed again after it.
+ * @param serverlist The list of the servers.
+ * @param acct If it is true the probes are sent to the accounting port, e.g.
+ * for servers which are only used for accounting.
+ */
+void RadiusClient::probeServers(list<RadiusServer> *serverlist, bool acct)
+{
+	list<RadiusServer>::iterator server;
+	RadiusRequest *req;
+	
+	for (server=serverlist->begin(); server!=serverlist->end(); server++)
+	{
+		if (!server->needsProbe())
+		{
+			continue;
+		}
+		RadiusPacket *packet=new RadiusPacket(STATUS_SERVER);
+		RadiusAttribute ra(ATTRIB_Message_Authenticator, "");
+		packet->addRadiusAttribute(&ra);
+		
+		server->setProbing(true);
+		req=new RadiusRequest;
+		req->packet=packet;
+		req->serverlist=serverlist;
+		req->server=server;
+		//no other server is tried
+		req->tried=serverlist->size()-1;
+		req->retries=0;
+		req->sock=-1;
+		req->result=NO_RESPONSE;
+		req->attempts=0;
+		req->ignorehealth=true;
+		req->probe=true;
+		req->acct=acct;
+		req->group=NULL;
+		req->twin=NULL;
+		req->hedge=false;
+		req->waiting=false;
+		timerclear(&req->hedgetime);
+		req->callback=probeDone;
+		req->arg=NULL;
+		this->outstanding++;
+		this->startRequest(req);
+	}
+}
+
+/** The method sends a packet to the server group and waits for the response. 
+ * Other requests are handled in the meantime.
+ * @param packet The packet to send.
+ * @param group The server group.
+ * @return 0 if a response was received, else NO_RESPONSE, 
+ * WRONG_AUTHENTICATOR_IN_RECV_PACKET, UNSHAPE_ERROR, UNKNOWN_HOST or SOCKET_ERROR.
+ */
+int RadiusClient::sendRequest(RadiusPacket *packet, RadiusServerGroup *group)
+{
+	//the results are 0 or negative
+	int result=1, ret;
+	
+	if ((ret=this->submit(packet, group, requestDone, &result))!=0)
+	{
+		return ret;
+	}
+	while (result==1)
+	{
+		this->poll(-1);
+	}
+	return result;
+}
+
+/** The getter method for the number of requests which are not finished.
+ * @return The number of requests.
+ */
+int RadiusClient::getOutstanding(void)
+{
+	return this->outstanding;
+}
@@ -0,0 +1,166 @@
+/*
+ *  RadiusClass -- An C++-Library for radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+#ifndef _RADIUSCLIENT_H_
+#define _RADIUSCLIENT_H_
+
+#include <sys/epoll.h>
+#include <sys/time.h>
+#include <map>
+#include <list>
+
+#include "error.h"
+#include "radius.h"
+#include "RadiusPacket.h"
+#include "RadiusServer.h"
+#include "RadiusServerGroup.h"
+
+using namespace std;
+
+/** The maximum number of outstanding requests on one socket, it is limited
+ * by the size of the identifier field.*/
+#define RADIUS_MAX_INFLIGHT 256
+
+/** The type of the function which is called when a request is finished.
+ * The first parameter is the packet of the request, if the result is 0 the
+ * attributes of the response are in the packet. The second parameter is the
+ * result, 0 or an error number from error.h. The third parameter is the argument
+ * which was given to RadiusClient::submit().*/
+typedef void (*RadiusCallback)(RadiusPacket *, int, void *);
+
+/** The class represents a request which is handled by the RadiusClient.*/
+class RadiusRequest
+{
+public:
+	RadiusPacket				*packet;	/**< The packet which is sent.*/
+	list<RadiusServer>			*serverlist;/**< The servers for the request.*/
+	list<RadiusServer>::iterator server;	/**< The server the packet is sent to.*/
+	int							tried;		/**< The number of servers which were tried.*/
+	int							retries;	/**< The number of transmissions to the current server.*/
+	int							sock;		/**< The socket of the current server, -1 if the request waits for a free identifier.*/
+	int							result;		/**< The result if no server sends a valid response.*/
+	int							attempts;	/**< The number of servers the packet was sent to.*/
+	bool						ignorehealth;/**< Is true if dead servers are not skipped.*/
+	bool						probe;		/**< Is true if the request is a Status-Server probe.*/
+	bool						acct;		/**< Is true if the packet is sent to the accounting port.*/
+	RadiusServerGroup			*group;		/**< The group of the servers, NULL if the request was submitted with a list.*/
+	RadiusRequest				*twin;		/**< The hedged copy of the request or, for the copy, the original request.*/
+	bool						hedge;		/**< Is true if the request is the hedged copy.*/
+	bool						waiting;	/**< Is true if the request has failed and waits for its hedged copy.*/
+	struct timeval				hedgetime;	/**< The time when the request is hedged, it is cleared if it is not hedged.*/
+	struct timeval				sent;		/**< The time when the packet was sent to the current server.*/
+	struct timeval				deadline;	/**< The time when the packet is sent again.*/
+	RadiusCallback				callback;	/**< The function which is called when the request is finished.*/
+	void						*arg;		/**< The argument for the callback.*/
+};
+
+/** The class represents the in-flight table of a socket. The requests
+ * are found by the identifier of the response.*/
+class RadiusInFlight
+{
+public:
+	RadiusRequest	*slot[RADIUS_MAX_INFLIGHT];	/**< The requests indexed by the identifier.*/
+	int				count;						/**< The number of used slots.*/
+	int				next;						/**< The next identifier which is tried.*/
+};
+
+/** The class represents the buffers of a stream socket (TCP or Unix).
+ * The packets are framed by their length field (RFC 6613). The packets which
+ * can't be written, e.g. until the connect is finished, are queued.*/
+class RadiusStream
+{
+public:
+	RadiusServer	*server;						/**< The server of the stream.*/
+	bool			connecting;						/**< Is true until the connect is finished.*/
+	int				events;							/**< The epoll events the stream is watched for, 0 if it is not watched.*/
+	vector<Octet>	out;							/**< The bytes which wait until the stream is writable.*/
+	int				len;							/**< The number of bytes in the buffer.*/
+	Octet			buffer[RADIUS_MAX_PACKET_LEN];	/**< The bytes of the packets which are not complete.*/
+};
+
+/** The class sends radius packets without blocking. Many requests 
+ * can be outstanding at the same time, on every socket up to 256 requests are
+ * tracked by their identifier. Retransmissions and failover to the next
+ * server are done per request, the retransmission timeout is calculated from 
+ * the round trip time of the server. If a request is finished the callback is called.
+ * Stream sockets (TCP or Unix) carry many requests, too, the packets are not
+ * sent again on a stream. A stream is connected without blocking, the packets
+ * are queued until it is writable. The sockets are waited for with epoll. Dead servers are skipped, as long 
+ * as one server of the list is alive. If hedging is switched on for a group,
+ * an Access-Request which is not answered in time is sent to the next server, 
+ * too, the first response is taken. The requests of a group with an in-flight
+ * limit wait in the client, if the limit is reached. Accounting-Requests
+ * which are submitted between startBatch() and sendBatch() are signed together.
+ */
+class RadiusClient
+{
+private:
+	int									epollfd;		/**< The epoll descriptor, it is created on the first use.*/
+	map<int, RadiusInFlight>			inflight;		/**< The in-flight tables of the sockets.*/
+	list<RadiusRequest *>				pending;		/**< The requests which wait for a free identifier.*/
+	list<RadiusRequest *>				limited;		/**< The requests which wait for the in-flight limit of their group.*/
+	map<int, RadiusStream>				streams;		/**< The receive buffers of the stream sockets.*/
+	bool								batching;		/**< Is true between startBatch() and sendBatch().*/
+	list<RadiusRequest *>				batch;			/**< The requests with Accounting-Requests which wait for sendBatch().*/
+	int									outstanding;	/**< The number of requests which are not finished.*/
+	Octet								buffer[RADIUS_MAX_PACKET_LEN]; /**< The receive buffer.*/
+	
+	RadiusClient(const RadiusClient &);
+	RadiusClient &operator=(const RadiusClient &);
+	
+	int		submitRequest(RadiusPacket *, list<RadiusServer> *, RadiusServerGroup *, list<RadiusServer>::iterator, RadiusCallback, void *);
+	int		startRequest(RadiusRequest *);
+	void	nextServer(RadiusRequest *);
+	void	failServer(RadiusRequest *);
+	void	releaseSlot(RadiusRequest *);
+	void	finishRequest(RadiusRequest *, int);
+	void	freeRequest(RadiusRequest *);
+	void	startHedge(RadiusRequest *);
+	void	startLimited(RadiusServerGroup *);
+	int		transmit(RadiusRequest *);
+	int		watchStream(int, RadiusStream *);
+	bool	writeStream(int, RadiusStream *);
+	void	readSocket(int);
+	void	readStream(int, RadiusStream *);
+	void	receivePacket(int, const Octet *, int);
+	void	closeStream(int, RadiusServer *, bool restart=false);
+	void	closeStaleSockets(RadiusServer *);
+	void	checkTimeouts(void);
+	int		getTimeout(int);
+	
+public:
+	RadiusClient(void);
+	~RadiusClient(void);
+	
+	int		submit(RadiusPacket *, list<RadiusServer> *, RadiusCallback, void *);
+	int		submit(RadiusPacket *, RadiusServerGroup *, RadiusCallback, void *);
+	void	startBatch(void);
+	void	sendBatch(void);
+	int		poll(int);
+	void	run(void);
+	int		sendRequest(RadiusPacket *, list<RadiusServer> *);
+	int		sendRequest(RadiusPacket *, RadiusServerGroup *);
+	void	probeServers(list<RadiusServer> *, bool acct=false);
+	
+	int		getOutstanding(void);
+};
+
+#endif //_RADIUSCLIENT_H_
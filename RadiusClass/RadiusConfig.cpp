@@ -33,6 +33,7 @@ RadiusConfig::RadiusConfig(void)
 	memset(this->serviceType,0,2);
 	memset(this->nasIdentifier,0,128);
 	memset(this->nasIpAddress,0,16);
+	this->attributesvalid=false;
 	
 }
 
@@ -49,6 +50,7 @@ RadiusConfig::RadiusConfig(string configfile)
 	memset(this->serviceType,0,2);
 	memset(this->nasIdentifier,0,128);
 	memset(this->nasIpAddress,0,16);
+	this->attributesvalid=false;
 	this->parseConfigFile(configfile.c_str());
 }
 
@@ -57,16 +59,191 @@ RadiusConfig::RadiusConfig(string configfile)
 RadiusConfig::~RadiusConfig(void)
 {
 	
-	server.clear();
+	authgroup.getServers()->clear();
+	acctgroup.getServers()->clear();
 	
 }
 
-/** The getter method for the radius server list.
+/** The getter method for the radius server list, it is
+ * the list of the servers for authentication.
  * @return The server list.*/
 
 list<RadiusServer> * RadiusConfig::getRadiusServer(void)
 {
-	return (&server);
+	return authgroup.getServers();
+}
+
+/** The getter method for the radius server group for authentication. 
+ * It has the servers of the server and authserver sections.
+ * @return The server group.*/
+
+RadiusServerGroup * RadiusConfig::getAuthServerGroup(void)
+{
+	return (&authgroup);
+}
+
+/** The getter method for the radius server group for accounting. 
+ * It has the servers of the server and acctserver sections.
+ * @return The server group.*/
+
+RadiusServerGroup * RadiusConfig::getAcctServerGroup(void)
+{
+	return (&acctgroup);
+}
+
+/** The method parses a realm section of the configfile. The
+ * servers of the realm are defined in the server sections with the realm option.
+ * @param file The configfile, the next line is the first line after the name of the section.
+ * @param line The buffer for the lines.
+ * @return 0 if everything is ok or PARSING_ERROR.*/
+int RadiusConfig::parseRealm(ifstream *file, string *line)
+{
+	RadiusRealm tmpRealm, *realm;
+	string name;
+	
+	while((line->find("{")==string::npos) && (file->eof()==false))
+	{
+		getline(*file,*line);
+		deletechars(line);
+		if(line->find_first_not_of("}"))
+		{
+			return PARSING_ERROR;	
+		}
+	}
+	while (strstr(line->c_str(),"}")==NULL && (file->eof()==false))
+	{
+		getline(*file,*line);
+		deletechars(line);
+		
+		if (strncmp(line->c_str(),"name=",5)==0)
+		{
+			name=getRealm("@"+line->substr(5));
+		}
+		if (strncmp(line->c_str(),"balance=",8)==0)
+		{
+			if (tmpRealm.authgroup.setPolicy(line->substr(8))!=0 || tmpRealm.acctgroup.setPolicy(line->substr(8))!=0)
+			{
+				return PARSING_ERROR;
+			}
+		}
+		if (strncmp(line->c_str(),"authbalance=",12)==0)
+		{
+			if (tmpRealm.authgroup.setPolicy(line->substr(12))!=0)
+			{
+				return PARSING_ERROR;
+			}
+		}
+		if (strncmp(line->c_str(),"acctbalance=",12)==0)
+		{
+			if (tmpRealm.acctgroup.setPolicy(line->substr(12))!=0)
+			{
+				return PARSING_ERROR;
+			}
+		}
+		if (strncmp(line->c_str(),"hedge=",6)==0)
+		{
+			tmpRealm.authgroup.setHedgePercentile(atoi(line->substr(6).c_str()));
+		}
+		if (strncmp(line->c_str(),"hedgebudget=",12)==0)
+		{
+			tmpRealm.authgroup.setHedgeBudget(atoi(line->substr(12).c_str()));
+		}
+		if (strncmp(line->c_str(),"maxinflight=",12)==0)
+		{
+			tmpRealm.authgroup.setMaxInFlight(atoi(line->substr(12).c_str()));
+			tmpRealm.acctgroup.setMaxInFlight(atoi(line->substr(12).c_str()));
+		}
+	}
+	//No "}" or no name was found - something in config is wrong
+	if (strstr(line->c_str(),"}")==NULL || name.empty())
+	{
+		return PARSING_ERROR;
+	}
+	
+	//the servers of the realm may be defined before
+	realm=&this->realms[name];
+	realm->authgroup.setPolicy(tmpRealm.authgroup.getPolicy());
+	realm->authgroup.setHedgePercentile(tmpRealm.authgroup.getHedgePercentile());
+	realm->authgroup.setHedgeBudget(tmpRealm.authgroup.getHedgeBudget());
+	realm->authgroup.setMaxInFlight(tmpRealm.authgroup.getMaxInFlight());
+	realm->acctgroup.setPolicy(tmpRealm.acctgroup.getPolicy());
+	realm->acctgroup.setMaxInFlight(tmpRealm.acctgroup.getMaxInFlight());
+	return 0;
+}
+
+/** The method divides the limits of the authentication server groups 
+ * between the authentication processes, see RadiusServerGroup::shareLimits().
+ * @param workers The number of authentication processes.
+ */
+void RadiusConfig::shareAuthLimits(int workers)
+{
+	this->authgroup.shareLimits(workers);
+	for (unordered_map<string, RadiusRealm>::iterator it=this->realms.begin(); it!=this->realms.end(); it++)
+	{
+		it->second.authgroup.shareLimits(workers);
+	}
+}
+
+/** The method finds the realm of a user name. The realm 
+ * is given as user@realm or realm\user.
+ * @param username The user name.
+ * @return The realm in lower case, it is empty if the 
+ * user name has no realm.
+ */
+string RadiusConfig::getRealm(const string &username)
+{
+	string realm;
+	string::size_type pos, i;
+	
+	if ((pos=username.rfind('@'))!=string::npos)
+	{
+		realm=username.substr(pos+1);
+	}
+	else if ((pos=username.find('\\'))!=string::npos)
+	{
+		realm=username.substr(0,pos);
+	}
+	for (i=0; i<realm.size(); i++)
+	{
+		realm[i]=tolower(realm[i]);
+	}
+	return realm;
+}
+
+/** The getter method for the radius server group for the authentication
+ * of a user. If the realm of the user name has own servers, they are used, 
+ * else the authentication server group.
+ * @param username The user name.
+ * @return The server group.*/
+
+RadiusServerGroup * RadiusConfig::getAuthServerGroup(const string &username)
+{
+	unordered_map<string, RadiusRealm>::iterator it;
+	
+	if (!this->realms.empty() && (it=this->realms.find(getRealm(username)))!=this->realms.end() &&
+		!it->second.authgroup.getServers()->empty())
+	{
+		return (&it->second.authgroup);
+	}
+	return (&authgroup);
+}
+
+/** The getter method for the radius server group for the accounting
+ * of a user. If the realm of the user name has own servers, they are used, 
+ * else the accounting server group.
+ * @param username The user name.
+ * @return The server group.*/
+
+RadiusServerGroup * RadiusConfig::getAcctServerGroup(const string &username)
+{
+	unordered_map<string, RadiusRealm>::iterator it;
+	
+	if (!this->realms.empty() && (it=this->realms.find(getRealm(username)))!=this->realms.end() &&
+		!it->second.acctgroup.getServers()->empty())
+	{
+		return (&it->second.acctgroup);
+	}
+	return (&acctgroup);
 }
 
 /** The method parse the configfile for attributes and 
@@ -80,7 +257,10 @@ int RadiusConfig::parseConfigFile(const char * configfile)
 	string line;
 	
 	RadiusServer *tmpServer=NULL;
+	bool auth, acct;
+	string realm;
 	ifstream file;
+	this->attributesvalid=false;
 	file.open(configfile, ios::in);
 	if (file.is_open())
 	{
@@ -128,8 +308,55 @@ int RadiusConfig::parseConfigFile(const char * configfile)
 				}
 				line.copy(this->nasIpAddress,line.size()-15,15);
 			}
-			if(strncmp(line.c_str(),"server",6)==0)
+			if (strncmp(line.c_str(),"balance=",8)==0)
+			{
+				if (this->authgroup.setPolicy(line.substr(8))!=0 || this->acctgroup.setPolicy(line.substr(8))!=0)
+				{
+					return PARSING_ERROR;
+				}
+			}
+			if (strncmp(line.c_str(),"authbalance=",12)==0)
 			{
+				if (this->authgroup.setPolicy(line.substr(12))!=0)
+				{
+					return PARSING_ERROR;
+				}
+			}
+			if (strncmp(line.c_str(),"acctbalance=",12)==0)
+			{
+				if (this->acctgroup.setPolicy(line.substr(12))!=0)
+				{
+					return PARSING_ERROR;
+				}
+			}
+			if (strncmp(line.c_str(),"hedge=",6)==0)
+			{
+				this->authgroup.setHedgePercentile(atoi(line.substr(6).c_str()));
+			}
+			if (strncmp(line.c_str(),"hedgebudget=",12)==0)
+			{
+				this->authgroup.setHedgeBudget(atoi(line.substr(12).c_str()));
+			}
+			if (strncmp(line.c_str(),"maxinflight=",12)==0)
+			{
+				this->authgroup.setMaxInFlight(atoi(line.substr(12).c_str()));
+				this->acctgroup.setMaxInFlight(atoi(line.substr(12).c_str()));
+			}
+			if (strncmp(line.c_str(),"realm",5)==0 && line.find("=")==string::npos)
+			{
+				if (this->parseRealm(&file, &line)!=0)
+				{
+					return PARSING_ERROR;
+				}
+			}
+			//a server section is used for authentication and accounting,
+			//an authserver or acctserver section only for one of them
+			if(strncmp(line.c_str(),"server",6)==0 || strncmp(line.c_str(),"authserver",10)==0 ||
+				strncmp(line.c_str(),"acctserver",10)==0)
+			{
+				auth=(strncmp(line.c_str(),"acct",4)!=0);
+				acct=(strncmp(line.c_str(),"auth",4)!=0);
+				realm="";
 				tmpServer=new RadiusServer;
 				while((line.find("{")==string::npos) && (file.eof()==false))
 				{
@@ -171,10 +398,62 @@ int RadiusConfig::parseConfigFile(const char * configfile)
 					{
 						tmpServer->setWait(atoi(line.substr(5).c_str()));
 					}
+					if (strncmp(line.c_str(),"resolvettl=",11)==0)
+					{
+						tmpServer->setResolveTtl(atoi(line.substr(11).c_str()));
+					}
+					if (strncmp(line.c_str(),"maxfails=",9)==0)
+					{
+						tmpServer->setMaxFails(atoi(line.substr(9).c_str()));
+					}
+					if (strncmp(line.c_str(),"deadtime=",9)==0)
+					{
+						tmpServer->setDeadTime(atoi(line.substr(9).c_str()));
+					}
+					if (strncmp(line.c_str(),"statusserver=",13)==0)
+					{
+						string stmp=line.substr(13);
+						if (stmp=="true") tmpServer->setStatusServer(true);
+						else if (stmp=="false") tmpServer->setStatusServer(false);
+						else return PARSING_ERROR;
+					}
+					if (strncmp(line.c_str(),"rtomin=",7)==0)
+					{
+						tmpServer->setRtoMin(atoi(line.substr(7).c_str()));
+					}
+					if (strncmp(line.c_str(),"rtomax=",7)==0)
+					{
+						tmpServer->setRtoMax(atoi(line.substr(7).c_str()));
+					}
+					if (strncmp(line.c_str(),"weight=",7)==0)
+					{
+						tmpServer->setWeight(atoi(line.substr(7).c_str()));
+					}
+					if (strncmp(line.c_str(),"transport=",10)==0)
+					{
+						if (tmpServer->setTransport(line.substr(10))!=0)
+						{
+							return PARSING_ERROR;
+						}
+					}
+					if (strncmp(line.c_str(),"realm=",6)==0)
+					{
+						realm=getRealm("@"+line.substr(6));
+					}
 				}
 				if(strstr(line.c_str(),"}"))
 				{
-					this->server.push_back(*tmpServer);
+					//the server of a realm is only used for the realm
+					if (auth)
+					{
+						if (realm.empty()) this->authgroup.addServer(*tmpServer);
+						else this->realms[realm].authgroup.addServer(*tmpServer);
+					}
+					if (acct)
+					{
+						if (realm.empty()) this->acctgroup.addServer(*tmpServer);
+						else this->realms[realm].acctgroup.addServer(*tmpServer);
+					}
 				}
 				//No "}" was found - something in config is wrong
 				else
@@ -263,6 +542,7 @@ void RadiusConfig::getValue(const char * text, char * value)
 void RadiusConfig::setServiceType(char * type)
 {
 	strncpy(this->serviceType, type, 2);
+	this->attributesvalid=false;
 }
 
 /** The getter method for the service type
@@ -277,6 +557,7 @@ char * RadiusConfig::getServiceType(void)
 void RadiusConfig::setFramedProtocol(char * proto)
 {
 	strncpy(this->framedProtocol, proto, 2);
+	this->attributesvalid=false;
 }
 
 /**The getter method for the framed protocol
@@ -294,6 +575,7 @@ char * RadiusConfig::getFramedProtocol(void)
 void RadiusConfig::setNASPortType(char * type)
 {
 	strncpy(this->nasPortType, type, 2);
+	this->attributesvalid=false;
 }
 
 /** The getter method for the nas port type.
@@ -310,6 +592,7 @@ char * RadiusConfig::getNASPortType(void)
 void RadiusConfig::setNASIdentifier(char * identifier)
 {
 	strncpy(this->nasIdentifier,identifier, 128);
+	this->attributesvalid=false;
 }
 
 /** The getter method for the nas identifier.
@@ -327,6 +610,7 @@ char * RadiusConfig::getNASIdentifier(void)
 void RadiusConfig::setNASIpAddress(char * ip)
 {
 	strncpy(this->nasIpAddress,ip, 16);
+	this->attributesvalid=false;
 }
 
 
@@ -338,10 +622,88 @@ char * RadiusConfig::getNASIpAddress(void)
 	return this->nasIpAddress;
 }
 
+/** The method serializes the nas attributes of the configuration once,
+ * so they can be appended to every packet without parsing the values again.
+ */
+void RadiusConfig::buildAttributes(void)
+{
+	RadiusPacket	packet;
+	const Octet		*value;
+	int				len;
+	
+	if(strcmp(this->nasIdentifier,""))
+	{
+		if (packet.appendAttribute(ATTRIB_NAS_Identifier, this->nasIdentifier)<0)
+		{
+			cerr << "RADIUS-CLASS: Fail to add attribute ATTRIB_NAS_Identifier.\n";
+		}
+	}
+	if(strcmp(this->nasIpAddress,""))
+	{
+		if (packet.appendIpAddress(ATTRIB_NAS_IP_Address, this->nasIpAddress)<0)
+		{
+			cerr << "RADIUS-CLASS: Fail to set value ATTRIB_NAS_Ip_Address.\n";
+		}
+	}
+	if(strcmp(this->nasPortType,""))
+	{
+		if (packet.appendInteger(ATTRIB_NAS_Port_Type, atoi(this->nasPortType))<0)
+		{
+			cerr << "RADIUS-CLASS: Fail to add attribute ATTRIB_NAS_Port_Type.\n";
+		}
+	}
+	if(strcmp(this->serviceType,""))
+	{
+		if (packet.appendInteger(ATTRIB_Service_Type, atoi(this->serviceType))<0)
+		{
+			cerr << "RADIUS-CLASS: Fail to add attribute ATTRIB_Service_Type.\n";
+		}
+	}
+	len=packet.getAttributes(&value);
+	this->authattributes.assign((const char *)value, len);
+	
+	//the framed protocol is only sent in accounting packets
+	if(strcmp(this->framedProtocol,""))
+	{
+		if (packet.appendInteger(ATTRIB_Framed_Protocol, atoi(this->framedProtocol))<0)
+		{
+			cerr << "RADIUS-CLASS: Fail to add attribute ATTRIB_Framed_Protocol.\n";
+		}
+	}
+	len=packet.getAttributes(&value);
+	this->acctattributes.assign((const char *)value, len);
+	this->attributesvalid=true;
+}
+
+/** The getter method for the serialized nas attributes of the 
+ * authentication packets: NAS-Identifier, NAS-IP-Address, NAS-Port-Type
+ * and Service-Type, if they are configured.
+ * @return A reference to the attributes in the network format.
+ */
+const string & RadiusConfig::getAuthAttributes(void)
+{
+	if (!this->attributesvalid)
+	{
+		this->buildAttributes();
+	}
+	return this->authattributes;
+}
+
+/** The getter method for the serialized nas attributes of the
+ * accounting packets, they have additionally the Framed-Protocol.
+ * @return A reference to the attributes in the network format.
+ */
+const string & RadiusConfig::getAcctAttributes(void)
+{
+	if (!this->attributesvalid)
+	{
+		this->buildAttributes();
+	}
+	return this->acctattributes;
+}
+
 ostream& operator << (ostream& os, RadiusConfig& config)
 {
-     list<RadiusServer> * serverlist;
-	 list<RadiusServer>::iterator server;
      os << "RadiusConfig: \n";
      os << "\nFramedProtocol: " << config.getFramedProtocol();
      os << "\nNASIdentifier: "<< config.getNASIdentifier();
@@ -349,15 +711,13 @@ ostream& operator << (ostream& os, RadiusConfig& config)
      os << "\nNASPortTyoe: "<< config.getNASPortType();
      os << "\nServiceType: " << config.getServiceType();
     
-	//get the server list
-	serverlist=config.getRadiusServer();
-	//set server to the first server
-	server=serverlist->begin();
- 	while(server != serverlist->end())
- 	{
- 		cout << *server;
- 		server++;
- 	}
+	os << "\n\nAuthentication:" << *config.getAuthServerGroup();
+	os << "\n\nAccounting:" << *config.getAcctServerGroup();
+	for (unordered_map<string, RadiusRealm>::iterator it=config.realms.begin(); it!=config.realms.end(); it++)
+	{
+		os << "\n\nRealm " << it->first << " Authentication:" << it->second.authgroup;
+		os << "\n\nRealm " << it->first << " Accounting:" << it->second.acctgroup;
+	}
  	
  	return os;
  	
@@ -29,28 +29,46 @@
 
 #include "RadiusServer.h"
 #include"RadiusServer.h"
+#include "RadiusServerGroup.h"
+#include "RadiusPacket.h"
 #include "error.h"
 
 #include <list>
+#include <unordered_map>
 #include <utility> 
 
 using std::list;
 using namespace std;
 
+/**This class represents the server groups of a realm.*/
+class RadiusRealm
+{
+public:
+	RadiusServerGroup authgroup; 	/**<The group of the radius server for authentication.*/
+	RadiusServerGroup acctgroup; 	/**<The group of the radius server for accounting.*/
+};
+
 /**This class represents the configurations attributes which 
  * can set in the configuration file and methods for the attributes.
  */
 class RadiusConfig
 {
 private:
-	list<RadiusServer> server; 		/**<An list with radius server, it is created dynamically by parsing the configuration file.*/
+	RadiusServerGroup authgroup; 	/**<The group of the radius server for authentication, it is created dynamically by parsing the configuration file.*/
+	RadiusServerGroup acctgroup; 	/**<The group of the radius server for accounting, it is created dynamically by parsing the configuration file.*/
+	unordered_map<string, RadiusRealm> realms; /**<The server groups of the realms, the key is the realm in lower case.*/
 	char serviceType[2]; 			/**<The service type which is set in the radius packet.*/
     char framedProtocol[2]; 		/**<The framed protocol which is set in the radius packet as an attribute.*/
     char nasPortType[2]; 			/**<The nas port type which is set in radius packet.*/
     char nasIdentifier[128]; 		/**<The nas identifier which is set in the radius packet.*/
     char nasIpAddress[16]; 			/**<The nas ipaddress which is set in the radius packet.*/
+	string authattributes;			/**<The serialized nas attributes for the authentication packets, they are built on the first use.*/
+	string acctattributes;			/**<The serialized nas attributes for the accounting packets, the same like above with the framed protocol.*/
+	bool attributesvalid;			/**<Is true if the serialized attributes are built from the current values.*/
     
 	void deletechars(string *);
+	int parseRealm(ifstream *, string *);
+	void buildAttributes(void);
 	
 	
 public:
@@ -65,6 +83,13 @@ public:
 	void getValue(const char * text, char * value);
 	
 	list<RadiusServer>* getRadiusServer(void);
+	RadiusServerGroup* getAuthServerGroup(void);
+	RadiusServerGroup* getAcctServerGroup(void);
+	RadiusServerGroup* getAuthServerGroup(const string &username);
+	RadiusServerGroup* getAcctServerGroup(const string &username);
+	
+	static string getRealm(const string &username);
+	void shareAuthLimits(int);
 	
 	
 	void setServiceType(char *);
@@ -83,6 +108,9 @@ public:
     char * getNASIpAddress(void);
 	void setNASIpAddress(char * );
 	
+	const string & getAuthAttributes(void);
+	const string & getAcctAttributes(void);
+	
 	
 	
 	friend ostream& operator << (ostream& os, RadiusConfig& config);
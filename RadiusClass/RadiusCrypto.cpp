@@ -0,0 +1,240 @@
+/*
+ *  RadiusClass -- An C++-Library for radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+
+#include "RadiusCrypto.h"
+#include "RadiusMd5.h"
+#include <string.h>
+#include <iostream>
+#define NEED_LIBGCRYPT_VERSION "1.2.0"
+GCRY_THREAD_OPTION_PTHREAD_IMPL;
+
+bool RadiusCrypto::initialized=false;
+
+/** The constructor creates a context without a secret.*/
+RadiusCrypto::RadiusCrypto(void)
+{
+	this->prefix=NULL;
+	this->hmac=NULL;
+}
+
+/** The copy constructor opens new contexts with the secret of c.
+ * @param c The context to copy.
+ */
+RadiusCrypto::RadiusCrypto(const RadiusCrypto &c)
+{
+	this->prefix=NULL;
+	this->hmac=NULL;
+	this->setSecret(c.secret);
+}
+
+/** The destructor closes the contexts.*/
+RadiusCrypto::~RadiusCrypto(void)
+{
+	this->close();
+}
+
+/** The assignment operator opens new contexts with the secret of c.
+ * @param c The context to copy.
+ * @return A reference to this.
+ */
+RadiusCrypto & RadiusCrypto::operator=(const RadiusCrypto &c)
+{
+	if (this!=&c)
+	{
+		this->setSecret(c.secret);
+	}
+	return *this;
+}
+
+/** The method closes the contexts.*/
+void RadiusCrypto::close(void)
+{
+	if (this->prefix!=NULL)
+	{
+		gcry_md_close(this->prefix);
+		this->prefix=NULL;
+	}
+	if (this->hmac!=NULL)
+	{
+		gcry_md_close(this->hmac);
+		this->hmac=NULL;
+	}
+}
+
+/** The method initializes libgcrypt, if no other library has done it.
+ * It should be called once at the start of the program, before
+ * threads are created. Later calls do nothing.
+ */
+void RadiusCrypto::init(void)
+{
+	if (initialized)
+	{
+		return;
+	}
+	initialized=true;
+	if (!gcry_control (GCRYCTL_ANY_INITIALIZATION_P))
+	{ /* No other library has already initialized libgcrypt. */
+
+	  gcry_control(GCRYCTL_SET_THREAD_CBS,&gcry_threads_pthread);
+
+	  if (!gcry_check_version (NEED_LIBGCRYPT_VERSION) )
+	    {
+		cerr << "libgcrypt is too old (need " << NEED_LIBGCRYPT_VERSION << ", have " << gcry_check_version (NULL) << ")\n";
+	    }
+	    /* Disable secure memory.  */
+	  gcry_control (GCRYCTL_DISABLE_SECMEM, 0);
+	  gcry_control (GCRYCTL_INITIALIZATION_FINISHED);
+	}
+}
+
+/** The method sets the shared secret, it hashes the secret into
+ * a new MD5 context and sets it as key of a new HMAC-MD5 context.
+ * @param secret The shared secret in plaintext.
+ */
+void RadiusCrypto::setSecret(const string &secret)
+{
+	init();
+	this->close();
+	this->secret=secret;
+	
+	if (gcry_md_open(&this->prefix, GCRY_MD_MD5, 0)!=0)
+	{
+		this->prefix=NULL;
+	}
+	else
+	{
+		gcry_md_write(this->prefix, this->secret.c_str(), this->secret.length());
+	}
+	if (gcry_md_open(&this->hmac, GCRY_MD_MD5, GCRY_MD_FLAG_HMAC)!=0)
+	{
+		this->hmac=NULL;
+	}
+	else if (gcry_md_setkey(this->hmac, this->secret.c_str(), this->secret.length())!=0)
+	{
+		gcry_md_close(this->hmac);
+		this->hmac=NULL;
+	}
+}
+
+/** The method calculates MD5(secret + value). The saved state
+ * after the secret is cloned, so the secret isn't hashed again.
+ * @param value The data which is hashed after the secret.
+ * @param len The length of the data.
+ * @param digest An array for the 16 octets of the hash.
+ */
+void RadiusCrypto::hashSecret(const void *value, int len, Octet *digest)
+{
+	gcry_md_hd_t	context;
+	
+	if (this->prefix==NULL || gcry_md_copy(&context, this->prefix)!=0)
+	{
+		//there is no saved state, hash the secret again
+		gcry_md_open(&context, GCRY_MD_MD5, 0);
+		gcry_md_write(context, this->secret.c_str(), this->secret.length());
+	}
+	gcry_md_write(context, value, len);
+	memcpy(digest, gcry_md_read(context, GCRY_MD_MD5), MD5_DIGEST_LENGTH);
+	gcry_md_close(context);
+}
+
+/** The method hides a password like described in RFC 2865:
+ * c(i) = p(i) xor MD5(secret + c(i-1)), c(0) is the authenticator.
+ * @param password The padded password.
+ * @param len The length of the password, a multiple of 16.
+ * @param authenticator The request authenticator.
+ * @param hidden An array of the length len for the hidden password.
+ */
+void RadiusCrypto::hidePassword(const Octet *password, int len, const Octet *authenticator, Octet *hidden)
+{
+	Octet			digest[MD5_DIGEST_LENGTH];
+	const Octet		*prev=authenticator;
+	int				i,j;
+	
+	for (i=0;i<len;i+=MD5_DIGEST_LENGTH)
+	{
+		this->hashSecret(prev, MD5_DIGEST_LENGTH, digest);
+		for (j=0;j<MD5_DIGEST_LENGTH;j++)
+		{
+			hidden[i+j]=password[i+j]^digest[j];
+		}
+		prev=hidden+i;
+	}
+}
+
+/** The method calculates the HMAC-MD5 of the value with the secret 
+ * as key. The keyed context is cloned.
+ * @param value The data.
+ * @param len The length of the data.
+ * @param digest An array for the 16 octets of the HMAC.
+ */
+void RadiusCrypto::calcHmac(const void *value, int len, Octet *digest)
+{
+	gcry_md_hd_t	context;
+	
+	if (this->hmac==NULL || gcry_md_copy(&context, this->hmac)!=0)
+	{
+		gcry_md_open(&context, GCRY_MD_MD5, GCRY_MD_FLAG_HMAC);
+		gcry_md_setkey(context, this->secret.c_str(), this->secret.length());
+	}
+	gcry_md_write(context, value, len);
+	memcpy(digest, gcry_md_read(context, GCRY_MD_MD5), MD5_DIGEST_LENGTH);
+	gcry_md_close(context);
+}
+
+/** The method opens a MD5 context for a hash which ends with the 
+ * secret, like the authenticators. The data is written with gcry_md_write(),
+ * finishDigest() adds the secret and closes the context.
+ * @return The MD5 context.
+ */
+gcry_md_hd_t RadiusCrypto::startDigest(void)
+{
+	gcry_md_hd_t	context;
+	
+	init();
+	gcry_md_open(&context, GCRY_MD_MD5, 0);
+	return context;
+}
+
+/** The method hashes the secret into the context, copies 
+ * the hash and closes the context.
+ * @param context A context from startDigest().
+ * @param digest An array for the 16 octets of the hash.
+ */
+void RadiusCrypto::finishDigest(gcry_md_hd_t context, Octet *digest)
+{
+	gcry_md_write(context, this->secret.c_str(), this->secret.length());
+	memcpy(digest, gcry_md_read(context, GCRY_MD_MD5), MD5_DIGEST_LENGTH);
+	gcry_md_close(context);
+}
+
+/** The method calculates MD5(value + secret) for more values at the
+ * same time, see RadiusMd5. The hashes are the same as with
+ * startDigest() and finishDigest().
+ * @param count The number of values.
+ * @param values An array of the values.
+ * @param lens An array of the lengths of the values.
+ * @param digests An array of pointers to arrays of 16 octets for the hashes.
+ */
+void RadiusCrypto::digestBatch(int count, const Octet **values, const int *lens, Octet **digests)
+{
+	RadiusMd5::digest(count, values, lens, (const Octet *)this->secret.c_str(), this->secret.length(), digests);
+}
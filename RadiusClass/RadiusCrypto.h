@@ -0,0 +1,69 @@
+/*
+ *  RadiusClass -- An C++-Library for radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+
+#ifndef _RADIUSCRYPTO_H_
+#define _RADIUSCRYPTO_H_
+
+#include <gcrypt.h>
+#include <string>
+#include "radius.h"
+
+using namespace std;
+
+/** The class holds the hash contexts for the shared secret of a radius server.
+ * The MD5 state after the shared secret is saved, so the secret is hashed only once
+ * for the password hiding, the state is cloned for every block. The HMAC-MD5 context
+ * for the Message-Authenticator keeps the secret as key and is cloned too.
+ * The authenticators hash the secret at the end, they can't use a saved state.
+ * The saved contexts are never changed after setSecret(), so they can be used 
+ * by more threads.*/
+class RadiusCrypto
+{
+private:
+	string			secret;		/**<The shared secret in plaintext.*/
+	gcry_md_hd_t	prefix;		/**<The MD5 state after the shared secret, NULL if it is not open.*/
+	gcry_md_hd_t	hmac;		/**<The HMAC-MD5 context with the shared secret as key, NULL if it is not open.*/
+	
+	static bool		initialized; /**<Is true if init() was called.*/
+	
+	void			close(void);
+	
+public:
+					RadiusCrypto(void);
+					RadiusCrypto(const RadiusCrypto &);
+					~RadiusCrypto(void);
+	RadiusCrypto &	operator=(const RadiusCrypto &);
+	
+	static void		init(void);
+	
+	void			setSecret(const string &);
+	
+	void			hashSecret(const void *value, int len, Octet *digest);
+	void			hidePassword(const Octet *password, int len, const Octet *authenticator, Octet *hidden);
+	void			calcHmac(const void *value, int len, Octet *digest);
+	
+	gcry_md_hd_t	startDigest(void);
+	void			finishDigest(gcry_md_hd_t context, Octet *digest);
+	void			digestBatch(int count, const Octet **values, const int *lens, Octet **digests);
+};
+
+#endif //_RADIUSCRYPTO_H_
@@ -0,0 +1,68 @@
+/*
+ *  RadiusClass -- An C++-Library for radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+
+#include "RadiusDictionary.h"
+#include <stdlib.h>
+#include "vsadict.h"
+
+/** The hash function of the table, vsadict.pl uses the same function.
+ * @param vendor The vendor id.
+ * @param type The type of the attribute.
+ * @param seed The seed, 0 for the bucket, else the displacement of the bucket.
+ * @return The hash.
+ */
+static inline uint32_t hashKey(uint32_t vendor, uint32_t type, uint32_t seed)
+{
+	uint32_t h;
+	
+	h=(seed*0x9e3779b9U)^vendor;
+	h=(h*0x01000193U)^type;
+	h*=0x01000193U;
+	h^=h>>15;
+	h*=0x2c1b3c6dU;
+	h^=h>>12;
+	return h;
+}
+
+/** The method finds a vendor specific attribute in the dictionary.
+ * @param vendor The vendor id.
+ * @param type The type of the attribute.
+ * @return A pointer to the attribute or NULL if it is not in the dictionary.
+ */
+const RadiusDictionaryEntry * RadiusDictionary::find(uint32_t vendor, int type)
+{
+	const RadiusDictionaryEntry *entry;
+	unsigned short seed, slot;
+	
+	seed=vsadict_displacement[hashKey(vendor, type, 0) & (VSADICT_BUCKETS-1)];
+	slot=vsadict_slot[hashKey(vendor, type, seed) & (VSADICT_SIZE-1)];
+	if (slot==0)
+	{
+		return NULL;
+	}
+	entry=&vsadict_entries[slot-1];
+	if (entry->vendor!=vendor || entry->type!=type)
+	{
+		return NULL;
+	}
+	return entry;
+}
@@ -0,0 +1,55 @@
+/*
+ *  RadiusClass -- An C++-Library for radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+
+#ifndef _RADIUSDICTIONARY_H_
+#define _RADIUSDICTIONARY_H_
+
+#include <stdint.h>
+
+/** The data types of the vendor specific attributes.*/
+#define RADIUS_VSA_OTHER	0	/**< A type which is not decoded, the value is treated as string.*/
+#define RADIUS_VSA_INTEGER	1	/**< A 32 bit integer.*/
+#define RADIUS_VSA_DATE		2	/**< A 32 bit time in seconds.*/
+#define RADIUS_VSA_STRING	3	/**< A string.*/
+#define RADIUS_VSA_IPADDR	4	/**< An IPv4 address.*/
+
+/** The class represents a vendor specific attribute of the dictionary.*/
+class RadiusDictionaryEntry
+{
+public:
+	uint32_t		vendor;		/**<The vendor id.*/
+	unsigned short	type;		/**<The type of the attribute.*/
+	unsigned short	datatype;	/**<The data type, see RADIUS_VSA_*.*/
+	const char		*name;		/**<The name of the attribute.*/
+};
+
+/** The class finds the vendor specific attributes of the dictionary 
+ * RadiusClass/utilities/dictionary. The table is generated by the build with
+ * utilities/vsadict.pl, the attributes are found with a perfect hash over
+ * the vendor id and the type.*/
+class RadiusDictionary
+{
+public:
+	static const RadiusDictionaryEntry *	find(uint32_t vendor, int type);
+};
+
+#endif //_RADIUSDICTIONARY_H_
@@ -0,0 +1,377 @@
+/*
+ *  RadiusClass -- An C++-Library for radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+
+#include "RadiusMd5.h"
+#include <string.h>
+#include <stdint.h>
+
+/** The functions and the step of MD5 (RFC 1321). They are macros, so they 
+ * work on an uint32_t and on the vector types of the SIMD lanes.*/
+#define MD5_F(x, y, z)	((z) ^ ((x) & ((y) ^ (z))))
+#define MD5_G(x, y, z)	((y) ^ ((z) & ((x) ^ (y))))
+#define MD5_H(x, y, z)	((x) ^ (y) ^ (z))
+#define MD5_I(x, y, z)	((y) ^ ((x) | ~(z)))
+#define MD5_STEP(f, a, b, c, d, x, t, s) \
+	(a) += f((b), (c), (d)) + (x) + (uint32_t)(t); \
+	(a) = (((a) << (s)) | ((a) >> (32 - (s)))) + (b);
+
+#if defined(__GNUC__)
+#define MD5_INLINE	inline __attribute__((always_inline))
+/** Four 32 bit lanes, GCC uses SSE2 or NEON for the operations.*/
+typedef uint32_t md5x4_t __attribute__((vector_size(16)));
+#if defined(__x86_64__) || defined(__i386__)
+#define MD5_AVX2
+/** Eight 32 bit lanes for AVX2.*/
+typedef uint32_t md5x8_t __attribute__((vector_size(32)));
+#endif
+#else
+#define MD5_INLINE	inline
+#endif
+
+/** The class describes a message of a lane, the message 
+ * is the value, the suffix and the MD5 padding.*/
+class RadiusMd5Lane
+{
+public:
+	const Octet		*value;		/**<The value.*/
+	int				len;		/**<The length of the value.*/
+	const Octet		*suffix;	/**<The suffix.*/
+	int				suffixlen;	/**<The length of the suffix.*/
+	int				blocks;		/**<The number of 64 octet blocks with the padding, 0 if the lane is not used.*/
+	Octet			*digest;	/**<The array for the hash.*/
+};
+
+/** The function returns a block of the padded message of a lane. A block
+ * in the value is not copied, the other blocks are built in the array block.
+ * @param lane The lane.
+ * @param k The number of the block.
+ * @param block An array of 64 octets for the block.
+ * @return A pointer to the block.
+ */
+static const Octet * getBlock(const RadiusMd5Lane *lane, int k, Octet *block)
+{
+	int			start=k*64, 
+				total=lane->len+lane->suffixlen,
+				from, to, i;
+	uint64_t	bits;
+	
+	if (start+64<=lane->len)
+	{
+		return lane->value+start;
+	}
+	memset(block, 0, 64);
+	if (k>=lane->blocks)
+	{
+		return block;
+	}
+	
+	//the part of the value in the block
+	from=start;
+	to=lane->len<start+64 ? lane->len : start+64;
+	if (from<to)
+	{
+		memcpy(block, lane->value+from, to-from);
+	}
+	
+	//the part of the suffix in the block
+	from=start>lane->len ? start : lane->len;
+	to=total<start+64 ? total : start+64;
+	if (from<to)
+	{
+		memcpy(block+from-start, lane->suffix+from-lane->len, to-from);
+	}
+	
+	//the padding starts with a 1 bit, the length in bits is at the end of the last block
+	if (total>=start && total<start+64)
+	{
+		block[total-start]=0x80;
+	}
+	if (k==lane->blocks-1)
+	{
+		bits=(uint64_t)total*8;
+		for (i=0; i<8; i++)
+		{
+			block[56+i]=(Octet)(bits>>(8*i));
+		}
+	}
+	return block;
+}
+
+/** The function hashes the messages of N lanes. The lanes are hashed with
+ * the type V at the same time, V is an uint32_t or a vector of N uint32_t.
+ * @param lanes An array of N lanes.
+ */
+template <class V, int N>
+static MD5_INLINE void hashLanes(RadiusMd5Lane *lanes)
+{
+	Octet		block[N][64];
+	const Octet	*p[N];
+	uint32_t	words[N], state[4][N];
+	V			a, b, c, d, aa, bb, cc, dd, x[16];
+	int			blocks=0, k, w, l, i;
+	
+	for (l=0; l<N; l++)
+	{
+		if (lanes[l].blocks>blocks)
+		{
+			blocks=lanes[l].blocks;
+		}
+	}
+	
+	for (l=0; l<N; l++)
+	{
+		words[l]=0x67452301;
+	}
+	memcpy(&a, words, sizeof(V));
+	for (l=0; l<N; l++)
+	{
+		words[l]=0xefcdab89;
+	}
+	memcpy(&b, words, sizeof(V));
+	for (l=0; l<N; l++)
+	{
+		words[l]=0x98badcfe;
+	}
+	memcpy(&c, words, sizeof(V));
+	for (l=0; l<N; l++)
+	{
+		words[l]=0x10325476;
+	}
+	memcpy(&d, words, sizeof(V));
+	
+	for (k=0; k<blocks; k++)
+	{
+		//load the words of the blocks into the lanes, the words are little endian
+		for (l=0; l<N; l++)
+		{
+			p[l]=getBlock(lanes+l, k, block[l]);
+		}
+		for (w=0; w<16; w++)
+		{
+			for (l=0; l<N; l++)
+			{
+				words[l]=(uint32_t)p[l][4*w] | ((uint32_t)p[l][4*w+1]<<8) |
+					((uint32_t)p[l][4*w+2]<<16) | ((uint32_t)p[l][4*w+3]<<24);
+			}
+			memcpy(&x[w], words, sizeof(V));
+		}
+		
+		aa=a; bb=b; cc=c; dd=d;
+		
+		MD5_STEP(MD5_F, a, b, c, d, x[0], 0xd76aa478, 7)
+		MD5_STEP(MD5_F, d, a, b, c, x[1], 0xe8c7b756, 12)
+		MD5_STEP(MD5_F, c, d, a, b, x[2], 0x242070db, 17)
+		MD5_STEP(MD5_F, b, c, d, a, x[3], 0xc1bdceee, 22)
+		MD5_STEP(MD5_F, a, b, c, d, x[4], 0xf57c0faf, 7)
+		MD5_STEP(MD5_F, d, a, b, c, x[5], 0x4787c62a, 12)
+		MD5_STEP(MD5_F, c, d, a, b, x[6], 0xa8304613, 17)
+		MD5_STEP(MD5_F, b, c, d, a, x[7], 0xfd469501, 22)
+		MD5_STEP(MD5_F, a, b, c, d, x[8], 0x698098d8, 7)
+		MD5_STEP(MD5_F, d, a, b, c, x[9], 0x8b44f7af, 12)
+		MD5_STEP(MD5_F, c, d, a, b, x[10], 0xffff5bb1, 17)
+		MD5_STEP(MD5_F, b, c, d, a, x[11], 0x895cd7be, 22)
+		MD5_STEP(MD5_F, a, b, c, d, x[12], 0x6b901122, 7)
+		MD5_STEP(MD5_F, d, a, b, c, x[13], 0xfd987193, 12)
+		MD5_STEP(MD5_F, c, d, a, b, x[14], 0xa679438e, 17)
+		MD5_STEP(MD5_F, b, c, d, a, x[15], 0x49b40821, 22)
+		
+		MD5_STEP(MD5_G, a, b, c, d, x[1], 0xf61e2562, 5)
+		MD5_STEP(MD5_G, d, a, b, c, x[6], 0xc040b340, 9)
+		MD5_STEP(MD5_G, c, d, a, b, x[11], 0x265e5a51, 14)
+		MD5_STEP(MD5_G, b, c, d, a, x[0], 0xe9b6c7aa, 20)
+		MD5_STEP(MD5_G, a, b, c, d, x[5], 0xd62f105d, 5)
+		MD5_STEP(MD5_G, d, a, b, c, x[10], 0x02441453, 9)
+		MD5_STEP(MD5_G, c, d, a, b, x[15], 0xd8a1e681, 14)
+		MD5_STEP(MD5_G, b, c, d, a, x[4], 0xe7d3fbc8, 20)
+		MD5_STEP(MD5_G, a, b, c, d, x[9], 0x21e1cde6, 5)
+		MD5_STEP(MD5_G, d, a, b, c, x[14], 0xc33707d6, 9)
+		MD5_STEP(MD5_G, c, d, a, b, x[3], 0xf4d50d87, 14)
+		MD5_STEP(MD5_G, b, c, d, a, x[8], 0x455a14ed, 20)
+		MD5_STEP(MD5_G, a, b, c, d, x[13], 0xa9e3e905, 5)
+		MD5_STEP(MD5_G, d, a, b, c, x[2], 0xfcefa3f8, 9)
+		MD5_STEP(MD5_G, c, d, a, b, x[7], 0x676f02d9, 14)
+		MD5_STEP(MD5_G, b, c, d, a, x[12], 0x8d2a4c8a, 20)
+		
+		MD5_STEP(MD5_H, a, b, c, d, x[5], 0xfffa3942, 4)
+		MD5_STEP(MD5_H, d, a, b, c, x[8], 0x8771f681, 11)
+		MD5_STEP(MD5_H, c, d, a, b, x[11], 0x6d9d6122, 16)
+		MD5_STEP(MD5_H, b, c, d, a, x[14], 0xfde5380c, 23)
+		MD5_STEP(MD5_H, a, b, c, d, x[1], 0xa4beea44, 4)
+		MD5_STEP(MD5_H, d, a, b, c, x[4], 0x4bdecfa9, 11)
+		MD5_STEP(MD5_H, c, d, a, b, x[7], 0xf6bb4b60, 16)
+		MD5_STEP(MD5_H, b, c, d, a, x[10], 0xbebfbc70, 23)
+		MD5_STEP(MD5_H, a, b, c, d, x[13], 0x289b7ec6, 4)
+		MD5_STEP(MD5_H, d, a, b, c, x[0], 0xeaa127fa, 11)
+		MD5_STEP(MD5_H, c, d, a, b, x[3], 0xd4ef3085, 16)
+		MD5_STEP(MD5_H, b, c, d, a, x[6], 0x04881d05, 23)
+		MD5_STEP(MD5_H, a, b, c, d, x[9], 0xd9d4d039, 4)
+		MD5_STEP(MD5_H, d, a, b, c, x[12], 0xe6db99e5, 11)
+		MD5_STEP(MD5_H, c, d, a, b, x[15], 0x1fa27cf8, 16)
+		MD5_STEP(MD5_H, b, c, d, a, x[2], 0xc4ac5665, 23)
+		
+		MD5_STEP(MD5_I, a, b, c, d, x[0], 0xf4292244, 6)
+		MD5_STEP(MD5_I, d, a, b, c, x[7], 0x432aff97, 10)
+		MD5_STEP(MD5_I, c, d, a, b, x[14], 0xab9423a7, 15)
+		MD5_STEP(MD5_I, b, c, d, a, x[5], 0xfc93a039, 21)
+		MD5_STEP(MD5_I, a, b, c, d, x[12], 0x655b59c3, 6)
+		MD5_STEP(MD5_I, d, a, b, c, x[3], 0x8f0ccc92, 10)
+		MD5_STEP(MD5_I, c, d, a, b, x[10], 0xffeff47d, 15)
+		MD5_STEP(MD5_I, b, c, d, a, x[1], 0x85845dd1, 21)
+		MD5_STEP(MD5_I, a, b, c, d, x[8], 0x6fa87e4f, 6)
+		MD5_STEP(MD5_I, d, a, b, c, x[15], 0xfe2ce6e0, 10)
+		MD5_STEP(MD5_I, c, d, a, b, x[6], 0xa3014314, 15)
+		MD5_STEP(MD5_I, b, c, d, a, x[13], 0x4e0811a1, 21)
+		MD5_STEP(MD5_I, a, b, c, d, x[4], 0xf7537e82, 6)
+		MD5_STEP(MD5_I, d, a, b, c, x[11], 0xbd3af235, 10)
+		MD5_STEP(MD5_I, c, d, a, b, x[2], 0x2ad7d2bb, 15)
+		MD5_STEP(MD5_I, b, c, d, a, x[9], 0xeb86d391, 21)
+		
+		a+=aa; b+=bb; c+=cc; d+=dd;
+		
+		//save the hashes of the lanes which end with this block
+		memcpy(state[0], &a, sizeof(V));
+		memcpy(state[1], &b, sizeof(V));
+		memcpy(state[2], &c, sizeof(V));
+		memcpy(state[3], &d, sizeof(V));
+		for (l=0; l<N; l++)
+		{
+			if (lanes[l].blocks==k+1)
+			{
+				for (i=0; i<16; i++)
+				{
+					lanes[l].digest[i]=(Octet)(state[i/4][l]>>(8*(i%4)));
+				}
+			}
+		}
+	}
+}
+
+/** The function hashes one lane without SIMD.
+ * @param lanes An array of one lane.
+ */
+static void hashLanes1(RadiusMd5Lane *lanes)
+{
+	hashLanes<uint32_t, 1>(lanes);
+}
+
+#if defined(__GNUC__)
+/** The function hashes 4 lanes with SSE2 or NEON.
+ * @param lanes An array of 4 lanes.
+ */
+static void hashLanes4(RadiusMd5Lane *lanes)
+{
+	hashLanes<md5x4_t, 4>(lanes);
+}
+#endif
+
+#if defined(MD5_AVX2)
+/** The function hashes 8 lanes with AVX2.
+ * @param lanes An array of 8 lanes.
+ */
+__attribute__((target("avx2")))
+static void hashLanes8(RadiusMd5Lane *lanes)
+{
+	hashLanes<md5x8_t, 8>(lanes);
+}
+#endif
+
+/** The method returns the number of lanes which the cpu supports.
+ * @return 8 with AVX2, 4 with SSE2 or NEON, else 1.
+ */
+int RadiusMd5::getLanes(void)
+{
+#if defined(MD5_AVX2)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return 8;
+	}
+	if (__builtin_cpu_supports("sse2"))
+	{
+		return 4;
+	}
+	return 1;
+#elif defined(__GNUC__) && (defined(__ARM_NEON) || defined(__ALTIVEC__))
+	return 4;
+#else
+	return 1;
+#endif
+}
+
+/** The method calculates MD5(value + suffix) for every value. The values
+ * are hashed in groups of as many lanes as the cpu supports.
+ * @param count The number of values.
+ * @param values An array of the values.
+ * @param lens An array of the lengths of the values.
+ * @param suffix The suffix which is hashed after every value.
+ * @param suffixlen The length of the suffix.
+ * @param digests An array of pointers to arrays of 16 octets for the hashes.
+ * @param lanes The maximum number of lanes, 0 uses all lanes of the cpu.
+ */
+void RadiusMd5::digest(int count, const Octet **values, const int *lens, 
+	const Octet *suffix, int suffixlen, Octet **digests, int lanes)
+{
+	static int		cpulanes=0;
+	RadiusMd5Lane	group[RADIUS_MD5_MAX_LANES];
+	int				i, l, n;
+	
+	if (cpulanes==0)
+	{
+		cpulanes=getLanes();
+	}
+	if (lanes<=0 || lanes>cpulanes)
+	{
+		lanes=cpulanes;
+	}
+	
+	for (i=0; i<count; i+=n)
+	{
+		n=count-i<lanes ? count-i : lanes;
+		memset(group, 0, sizeof(group));
+		for (l=0; l<n; l++)
+		{
+			group[l].value=values[i+l];
+			group[l].len=lens[i+l];
+			group[l].suffix=suffix;
+			group[l].suffixlen=suffixlen;
+			//the padding needs 9 octets: 0x80 and the length
+			group[l].blocks=(lens[i+l]+suffixlen+9+63)/64;
+			group[l].digest=digests[i+l];
+		}
+		
+#if defined(MD5_AVX2)
+		if (n>4)
+		{
+			hashLanes8(group);
+			continue;
+		}
+#endif
+#if defined(__GNUC__)
+		if (n>1)
+		{
+			hashLanes4(group);
+			continue;
+		}
+#endif
+		hashLanes1(group);
+	}
+}
@@ -0,0 +1,45 @@
+/*
+ *  RadiusClass -- An C++-Library for radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+
+#ifndef _RADIUSMD5_H_
+#define _RADIUSMD5_H_
+
+#include "radius.h"
+
+/** The maximum number of messages which are hashed at the same time.*/
+#define RADIUS_MD5_MAX_LANES	8
+
+/** The class hashes more messages at the same time with MD5. Every message
+ * is a lane of a SIMD register, the lanes are hashed block by block. AVX2 hashes 8 lanes,
+ * SSE2 4 lanes, without SIMD the messages are hashed one after another. 
+ * A shared suffix is hashed after every message, like the shared
+ * secret in the authenticator of an Accounting-Request.
+ * The hashes are the same as the hashes of libgcrypt.*/
+class RadiusMd5
+{
+public:
+	static int		getLanes(void);
+	static void		digest(int count, const Octet **values, const int *lens, 
+						const Octet *suffix, int suffixlen, Octet **digests, int lanes=0);
+};
+
+#endif //_RADIUSMD5_H_
@@ -20,19 +20,18 @@
  */
  
 #include "RadiusPacket.h"
-#define NEED_LIBGCRYPT_VERSION "1.2.0"
-GCRY_THREAD_OPTION_PTHREAD_IMPL;
 
 using namespace std;
 
-/** The destructur frees the dynamic allocated memory of the buffers,
- * closes the socket and clears the attribute multimap.
+/** The destructur frees the dynamic allocated memory of the buffers
+ * and clears the attribute multimap. The socket belongs to the RadiusServer
+ * and is not closed.
  */
 
 RadiusPacket::~RadiusPacket()
 {
 	
-	if (this->sendbuffer)
+	if (this->sendbuffer && this->sendbuffer!=this->flat)
 	{
 		delete [] (this->sendbuffer);
 	}
@@ -40,18 +39,47 @@ RadiusPacket::~RadiusPacket()
 	{
 		delete [] (this->recvbuffer);
 	}
-	
-	
-	if (this->sock)
-	{
-		close (this->sock);
-	}
 	this->attribs.clear();
 	
 }
 
+/** The constructor initializes the view, so RadiusPacket::nextAttribute()
+ * starts with the first attribute.
+ */
+RadiusAttributeView::RadiusAttributeView(void)
+{
+	this->type=0;
+	this->length=0;
+	this->offset=0;
+	this->value=NULL;
+}
+
+/** The method converts the value into an integer, the value must have 4 octets.
+ * @return The integer.
+ */
+int RadiusAttributeView::intFromBuf(void)
+{
+	return RadiusAttribute::intFromBuf(this->value);
+}
+
+/** The method converts the value into an ip.
+ * @return The ip address as a string.
+ */
+string RadiusAttributeView::ipFromBuf(void)
+{
+	return RadiusAttribute::ipFromBuf(this->value, this->length);
+}
+
+/** The method converts the value into an IPv6.
+ * @return The ip address as a string.
+ */
+string RadiusAttributeView::ip6FromBuf(void)
+{
+	return RadiusAttribute::ip6FromBuf(this->value, this->length);
+}
+
 /** The constructur sets the code and generate random numbers 
- * for the identifier. The socket and the buffer length are set to 0, the pointer 
+ * for the identifier. The buffer length is set to 0, the socket to -1, the pointer 
  * to the buffers is set to NULL. The length is set to 20 Bytes, this is the length without 
  * attributes. 
  * @param code The code of the packet.
@@ -59,7 +87,7 @@ RadiusPacket::~RadiusPacket()
 RadiusPacket::RadiusPacket(Octet code)
 {
 	this->code=code;
-	this->getRandom(RADIUS_PACKET_IDENTIFIER_LEN,&(this->identifier));
+	RadiusRandom::getBytes(&(this->identifier), RADIUS_PACKET_IDENTIFIER_LEN);
 	memset(this->authenticator,0,16);
 	memset(this->req_authenticator,0,16);
 	this->length=sizeof(Octet)*(RADIUS_PACKET_AUTHENTICATOR_LEN+4);
@@ -67,19 +95,23 @@ RadiusPacket::RadiusPacket(Octet code)
 	this->sendbufferlen=0;
 	this->recvbuffer=NULL;
 	this->recvbufferlen=0;
-	this->sock=0;
+	this->recvattribs=false;
+	this->flatlen=0;
+	this->passwordpos=0;
+	this->sock=-1;
+	this->sentserver=NULL;
 	
 }
 
 /** The constructur generates random numbers 
- * for the identifier. The socket, the code and the buffer length are set to 0, the pointer 
+ * for the identifier. The code and the buffer length are set to 0, the socket to -1, the pointer 
  * to the buffers is set to NULL. The length is set to 20 Bytes, this is the length without 
  * attributes. 
  */
 RadiusPacket::RadiusPacket(void)
 {
 	this->code=0;
-	this->getRandom(RADIUS_PACKET_IDENTIFIER_LEN,&(this->identifier));
+	RadiusRandom::getBytes(&(this->identifier), RADIUS_PACKET_IDENTIFIER_LEN);
 	memset(this->authenticator,0,16);
 	memset(this->req_authenticator,0,16);
 	this->length=sizeof(Octet)*(RADIUS_PACKET_AUTHENTICATOR_LEN+4);
@@ -87,10 +119,45 @@ RadiusPacket::RadiusPacket(void)
 	this->sendbufferlen=0;
 	this->recvbuffer=NULL;
 	this->recvbufferlen=0;
-	this->sock=0;
+	this->recvattribs=false;
+	this->flatlen=0;
+	this->passwordpos=0;
+	this->sock=-1;
+	this->sentserver=NULL;
 	
 }
 
+/** The copy constructor copies the code and the attributes, so the 
+ * request can be sent again with an own identifier and authenticator. 
+ * The buffers are not copied, except the buffer of the packet builder.
+ * @param p A reference to a RadiusPacket.
+ */
+RadiusPacket::RadiusPacket(const RadiusPacket &p)
+{
+	this->code=p.code;
+	this->attribs=p.attribs;
+	RadiusRandom::getBytes(&(this->identifier), RADIUS_PACKET_IDENTIFIER_LEN);
+	memset(this->authenticator,0,16);
+	memset(this->req_authenticator,0,16);
+	this->length=p.length;
+	this->sendbuffer=NULL;
+	this->sendbufferlen=0;
+	this->recvbuffer=NULL;
+	this->recvbufferlen=0;
+	this->recvattribs=false;
+	this->flatlen=p.flatlen;
+	this->passwordpos=p.passwordpos;
+	if (this->flatlen>0)
+	{
+		memcpy(this->flat, p.flat, this->flatlen);
+	}
+	if (this->passwordpos>0)
+	{
+		memcpy(this->password, p.password, RADIUS_MAX_PASSWORD_LEN);
+	}
+	this->sock=-1;
+	this->sentserver=NULL;
+}
 
 /** Create a dump of the radius packet
  */
@@ -98,6 +165,10 @@ void RadiusPacket::dumpRadiusPacket(void)
 {
 	
 
+	if (!this->recvattribs && this->recvbufferlen>0)
+	{
+		this->copyRecvAttributes();
+	}
 	fprintf(stdout,"\n-- RadiusPacket -----------------\n");
 	fprintf(stdout,"\tcode\t\t:\t%d\n",this->code);
 	fprintf(stdout,"\tidentifier\t:\t%d\n",this->identifier);
@@ -119,6 +190,10 @@ void RadiusPacket::dumpRadiusPacket(void)
 int RadiusPacket::getRadiusAttribNumber(void)
 {
 	int i=0;
+	if (!this->recvattribs && this->recvbufferlen>0)
+	{
+		this->copyRecvAttributes();
+	}
 	for (multimap<Octet, RadiusAttribute>::iterator it = attribs.begin(); it != attribs.end(); it++)
 	{
 		
@@ -150,20 +225,247 @@ int RadiusPacket::addRadiusAttribute(RadiusAttribute *ra)
 	return 0;
 }
 
+/** The method reserves the space for an attribute in the buffer of the
+ * packet builder and writes the type and the length of the attribute.
+ * @param type The type of the attribute.
+ * @param len The length of the value.
+ * @return The offset of the value in the packet, NO_VALUE_IN_ATTRIBUTE,
+ * TO_BIG_ATTRIBUTE_LENGTH or BAD_LENGTH in case of error.
+ */
+int RadiusPacket::reserveAttribute(Octet type, int len)
+{
+	int pos;
+	
+	if (len<1)
+	{
+		return NO_VALUE_IN_ATTRIBUTE;
+	}
+	if (len>253)
+	{
+		return TO_BIG_ATTRIBUTE_LENGTH;
+	}
+	//the header is written on shaping
+	if (this->flatlen==0)
+	{
+		this->flatlen=RADIUS_PACKET_AUTHENTICATOR_LEN+4;
+	}
+	if (this->flatlen+len+2>RADIUS_MAX_PACKET_LEN)
+	{
+		return BAD_LENGTH;
+	}
+	pos=this->flatlen;
+	this->flat[pos]=type;
+	this->flat[pos+1]=(Octet)(len+2);
+	this->flatlen+=len+2;
+	this->length=this->flatlen;
+	return pos+2;
+}
+
+/** The method appends an attribute to the packet builder. The value is
+ * copied in the network format directly into the buffer of the packet, so 
+ * no memory is allocated. A packet is either built with the builder or with
+ * addRadiusAttribute(), the attributes of the multimap are not sent, if the
+ * builder is used.
+ * @param type The type of the attribute.
+ * @param value A pointer to the value.
+ * @param len The length of the value.
+ * @return The offset of the value in the packet, it can be used to update
+ * the value in place, or an error from reserveAttribute().
+ */
+int RadiusPacket::appendAttribute(Octet type, const void *value, int len)
+{
+	int pos=this->reserveAttribute(type, len);
+	if (pos>0)
+	{
+		memcpy(this->flat+pos, value, len);
+	}
+	return pos;
+}
+
+/** The method appends a string attribute to the packet builder.
+ * @param type The type of the attribute.
+ * @param value The string.
+ * @return The offset of the value in the packet or an error from reserveAttribute().
+ */
+int RadiusPacket::appendAttribute(Octet type, const char *value)
+{
+	return this->appendAttribute(type, value, strlen(value));
+}
+
+/** The method appends an integer, enum or time attribute with 
+ * 4 octets in network byte order to the packet builder.
+ * @param type The type of the attribute.
+ * @param value The value.
+ * @return The offset of the value in the packet or an error from reserveAttribute().
+ */
+int RadiusPacket::appendInteger(Octet type, uint32_t value)
+{
+	int pos=this->reserveAttribute(type, 4);
+	if (pos>0)
+	{
+		this->setInteger(pos, value);
+	}
+	return pos;
+}
+
+/** The method appends an IPv4 address attribute to the packet builder.
+ * @param type The type of the attribute.
+ * @param value The address in dotted decimal notation.
+ * @return The offset of the value in the packet, BAD_IP or an error 
+ * from reserveAttribute().
+ */
+int RadiusPacket::appendIpAddress(Octet type, const char *value)
+{
+	struct in_addr	addr;
+	
+	if (inet_pton(AF_INET, value, &addr)!=1)
+	{
+		return BAD_IP;
+	}
+	return this->appendAttribute(type, &addr, 4);
+}
+
+/** The method appends the User-Password attribute to the packet builder.
+ * The plaintext is padded to a multiple of 16 octets and kept in the
+ * packet, it is hidden with the shared secret of the server on shaping.
+ * @param value The password in plaintext.
+ * @return The offset of the value in the packet, TO_LONG_PASSWORD or an
+ * error from reserveAttribute().
+ */
+int RadiusPacket::appendPassword(const char *value)
+{
+	int len=strlen(value),
+		padded=(len+15)&~15,
+		pos;
+	
+	if (len>RADIUS_MAX_PASSWORD_LEN || this->passwordpos>0)
+	{
+		return TO_LONG_PASSWORD;
+	}
+	if (padded==0)
+	{
+		padded=16;
+	}
+	pos=this->reserveAttribute(ATTRIB_User_Password, padded);
+	if (pos>0)
+	{
+		memset(this->password, 0, RADIUS_MAX_PASSWORD_LEN);
+		memcpy(this->password, value, len);
+		memset(this->flat+pos, 0, padded);
+		this->passwordpos=pos;
+	}
+	return pos;
+}
+
+/** The method appends a block of attributes, which were serialized 
+ * before by the packet builder, for ex. a template of the attributes
+ * which are the same in every packet.
+ * @param value The attributes in the network format.
+ * @param len The length of the attributes.
+ * @return The offset of the block in the packet or BAD_LENGTH.
+ */
+int RadiusPacket::appendAttributes(const Octet *value, int len)
+{
+	int pos;
+	
+	if (this->flatlen==0)
+	{
+		this->flatlen=RADIUS_PACKET_AUTHENTICATOR_LEN+4;
+	}
+	if (len<0 || this->flatlen+len>RADIUS_MAX_PACKET_LEN)
+	{
+		return BAD_LENGTH;
+	}
+	pos=this->flatlen;
+	memcpy(this->flat+pos, value, len);
+	this->flatlen+=len;
+	this->length=this->flatlen;
+	return pos;
+}
+
+/** The method returns the attributes of the packet builder in the 
+ * network format, so they can be saved as a template.
+ * @param value A pointer which is set to the attributes.
+ * @return The length of the attributes.
+ */
+int RadiusPacket::getAttributes(const Octet **value)
+{
+	*value=this->flat+RADIUS_PACKET_AUTHENTICATOR_LEN+4;
+	if (this->flatlen==0)
+	{
+		return 0;
+	}
+	return this->flatlen-RADIUS_PACKET_AUTHENTICATOR_LEN-4;
+}
+
+/** The method overwrites an integer value in the buffer of the packet builder.
+ * @param pos The offset of the value like it is returned by appendInteger().
+ * @param value The new value.
+ */
+void RadiusPacket::setInteger(int pos, uint32_t value)
+{
+	this->flat[pos]=(Octet)(value>>24);
+	this->flat[pos+1]=(Octet)(value>>16);
+	this->flat[pos+2]=(Octet)(value>>8);
+	this->flat[pos+3]=(Octet)value;
+}
+
+/** The method finds the first attribute with the given type in the 
+ * buffer of the packet builder. The User-Password is returned hidden.
+ * @param type The type of the attribute.
+ * @param value A pointer which is set to the value in the buffer, can be NULL.
+ * @return The length of the value or -1 if the attribute is not found.
+ */
+int RadiusPacket::findAttribute(Octet type, const Octet **value)
+{
+	int pos=RADIUS_PACKET_AUTHENTICATOR_LEN+4;
+	
+	while (pos+2<=this->flatlen)
+	{
+		if (this->flat[pos]==type)
+		{
+			if (value)
+			{
+				*value=this->flat+pos+2;
+			}
+			return this->flat[pos+1]-2;
+		}
+		pos+=this->flat[pos+1];
+	}
+	return -1;
+}
+
 
 /**	Formats a radiusPacket structure into a buffer that can be sent to a radius server via UDP.
  *	The destination buffer is put into sendbuffer while its length is put into sendbufferlen.
- *  @param sharedsecret The sharedsecret in plaintext.
+ *  @param crypto The hash contexts of the shared secret.
  *	@return Returns 0 if everything is ok, ALLOC_ERROR in case of error.
  */
-int RadiusPacket::shapeRadiusPacket(const char * sharedsecret)
+int RadiusPacket::shapeRadiusPacket(RadiusCrypto *crypto)
 {
 	int				i,j;
 	Octet *			value;
 	char * 			hashedpassword ;
 	
 	//fill the authenticator with random data
-	this->getRandom(RADIUS_PACKET_AUTHENTICATOR_LEN,this->authenticator);
+	RadiusRandom::getBytes(this->authenticator, RADIUS_PACKET_AUTHENTICATOR_LEN);
+	
+	//the packet builder was used, the buffer is sent as it is
+	if (this->flatlen>0)
+	{
+		this->sendbuffer=this->flat;
+		this->sendbufferlen=this->flatlen;
+		this->flat[0]=this->code;
+		this->flat[1]=this->identifier;
+		this->flat[2]=(Octet)(this->flatlen>>8);
+		this->flat[3]=(Octet)this->flatlen;
+		memcpy(this->flat+4, this->authenticator, RADIUS_PACKET_AUTHENTICATOR_LEN);
+		if (this->passwordpos>0)
+		{
+			crypto->hidePassword(this->password, this->flat[this->passwordpos-1]-2, this->authenticator, this->flat+this->passwordpos);
+		}
+		return 0;
+	}
 	
 	//free the buffer if it is not empty, for ex. if is send again
 	if(this->sendbuffer!=NULL)
@@ -205,7 +507,7 @@ int RadiusPacket::shapeRadiusPacket(const char * sharedsecret)
 			if (it->second.getLength()-2<=16)
 			{
 				hashedpassword=new char[16]; 
-				it->second.makePasswordHash((char *)it->second.getValue(),hashedpassword,sharedsecret,this->getAuthenticator());
+				it->second.makePasswordHash((char *)it->second.getValue(),hashedpassword,crypto,this->getAuthenticator());
 				for(j=0;j<16;j++)
 					this->sendbuffer[(this->sendbufferlen)++]=(Octet)hashedpassword[j];
 			
@@ -215,7 +517,7 @@ int RadiusPacket::shapeRadiusPacket(const char * sharedsecret)
 				
 				
 				hashedpassword = new char [it->second.getLength()-2];
-				it->second.makePasswordHash((char *)it->second.getValue(), hashedpassword, sharedsecret, this->getAuthenticator());
+				it->second.makePasswordHash((char *)it->second.getValue(), hashedpassword, crypto, this->getAuthenticator());
 				
 				for(j=0;j<(it->second.getLength()-2);j++)
 				{
@@ -309,104 +611,144 @@ void	RadiusPacket::dumpShapedRadiusPacket(void)
 }
 
 
-/**	Formats a UDP-received buffer radiusPacket structure
- *	@return A error number. Returns 0 is everything is ok, NO_BUFFER_TO_UNSHAPE 
- * or ALLOC_ERROR or TO_BIG_ATTRIBUTE_LENGTH in case of error.
+/** The method decodes the header of a received packet and validates
+ * the attributes once, so they can be iterated without further checks 
+ * by nextAttribute(). The attributes are not copied, the multimap is
+ * filled only on demand by findAttributes().
+ * @return 0 if the packet is valid, NO_BUFFER_TO_UNSHAPE or BAD_LENGTH.
  */
 int RadiusPacket::unShapeRadiusPacket(void)
 {
-	RadiusAttribute		*ra;
-	int					pos,i;
-    char				*value;
-    unsigned int        len;
+	int					pos,
+						len;
 	
 	//if the buffer is empty
-    if(!this->recvbuffer||this->recvbufferlen<=4)
+	if(!this->recvbuffer||this->recvbufferlen<20)
 	{
 		return NO_BUFFER_TO_UNSHAPE;
 	}
-		
+	
+	len=this->recvbuffer[2]*256+this->recvbuffer[3];
+	if (len<20 || this->recvbufferlen<len)
+	{
+		return BAD_LENGTH;
+	}
+	
+	//every attribute must have at least the type and the length 
+	//and must end within the packet
+	pos=20;
+	while (pos<len)
+	{
+		if (pos+2>len || this->recvbuffer[pos+1]<2 || pos+this->recvbuffer[pos+1]>len)
+		{
+			return BAD_LENGTH;
+		}
+		pos+=this->recvbuffer[pos+1];
+	}
 	
 	//	RADIUS packet header decoding
 	this->code=this->recvbuffer[0];
-	//cerr << getTime() << "\n\nCODE: %s\n\n", this->code);
-
 	this->identifier=this->recvbuffer[1];
-
-    len = this->recvbuffer[2]*256 + this->recvbuffer[3];
-
-    if (this->recvbufferlen < len)
-    {
-        return BAD_LENGTH;
-    }
-
 	memcpy(this->authenticator,recvbuffer+4,RADIUS_PACKET_AUTHENTICATOR_LEN);
 	
+	//octets behind the length are padding
+	this->length=len;
+	this->recvbufferlen=len;
+	this->recvattribs=false;
+	return 0;
+}
+
+/** The method copies the attributes of the received packet into the multimap
+ * for findAttributes(). 
+ */
+void RadiusPacket::copyRecvAttributes(void)
+{
+	RadiusAttributeView	view;
 	
-	//	RADIUS packet attributes decoding
-	pos=20;
-			
-    while(pos<len)
+	this->recvattribs=true;
+	while (this->nextAttribute(&view))
 	{
-		//for every turn create a new attribute
-		if(!(ra=new RadiusAttribute))
-		{
-			return ALLOC_ERROR;
-		}
-				
-		ra->setType(recvbuffer[pos++]);
-		ra->setLength(recvbuffer[pos++]);
-		
-		//the maximum attribute size can be 
-		//RADIUS_MAX_PACKET_LEN-20, 20: bytes of the
-		//packet header.
-		if(ra->getLength()>(RADIUS_MAX_PACKET_LEN-20))
-		{
-			return TO_BIG_ATTRIBUTE_LENGTH;
-		}
-        else if (ra->getLength()<2)
-        {
-            return BAD_LENGTH;
-        }
-		else
+		RadiusAttribute ra;
+		ra.setType(view.type);
+		ra.setLength(view.length+2);
+		ra.setRecvValue((char *)view.value);
+		attribs.insert(pair<Octet,RadiusAttribute>(view.type, ra));
+	}
+}
+
+/** The method iterates over the attributes of the received packet, the
+ * attributes are not copied. The view must be initialized with the default
+ * constructor to start with the first attribute:
+ *	RadiusAttributeView view;
+ *	while (packet->nextAttribute(&view, ATTRIB_Framed_Route)) { ... }
+ * @param view The view, it is set to the next attribute.
+ * @param type The type of the attributes, -1 for all attributes.
+ * @return True if an attribute is found, else false.
+ */
+bool RadiusPacket::nextAttribute(RadiusAttributeView *view, int type)
+{
+	int pos;
+	
+	//the first attribute follows the header
+	if (view->offset==0)
+	{
+		pos=20;
+	}
+	else
+	{
+		pos=view->offset+view->length;
+	}
+	while (pos+2<=this->recvbufferlen)
+	{
+		if (type<0 || this->recvbuffer[pos]==type)
 		{
-			value=new char [ra->getLength()-2];
-			for(i=0;i<(ra->getLength()-2);i++)
-			{
-				value[i]=recvbuffer[pos++];
-			}
-			ra->setRecvValue(value);		
-			this->addRadiusAttribute(ra);
-			this->length+=ra->getLength();
-			delete [] value;
-				
+			view->type=this->recvbuffer[pos];
+			view->length=this->recvbuffer[pos+1]-2;
+			view->offset=pos+2;
+			view->value=this->recvbuffer+pos+2;
+			return true;
 		}
-		//free the attribute, it was inserted in the list
-		delete ra;
+		pos+=this->recvbuffer[pos+1];
 	}
-	//set the right length
-    this->length=len;
-	
-	
-	return 0;
+	return false;
 }
 
+
 /**	The method sends the packet to a radius server.
+ * The packet is sent over the connected socket of the server,
+ * the socket is not closed after the packet is received, it is reused
+ * for the next packets.
  * @param server A iterator to a server.
  * @return Returns the number of bytes successfully sent, 
- * SOCKET_ERROR or UNKNOWN_HOST in case of error.
+ * SHAPE_ERROR, SOCKET_ERROR or UNKNOWN_HOST in case of error.
  */
 int RadiusPacket::radiusSend(list<RadiusServer>::iterator server)
 {
- 
-	int					socket2Radius;
-    struct hostent		*h;
-    struct sockaddr_in	cliAddr,remoteServAddr;
-    
-    //the packet is shaped here, the authenticator gets
-    //a new random value and then the buffer must be shaped again
-    //the password field depends on the authenticator field
-	if(this->shapeRadiusPacket(server->getSharedSecret().c_str())!=0)
+	int result;
+	
+	if ((result=this->radiusShape(&(*server)))<0)
+	{
+		return result;
+	}
+	return this->radiusTransmit();
+}
+
+
+/** The method shapes the packet for a radius server, so
+ * it can be sent with radiusTransmit(). The authenticator gets
+ * a new random value and then the buffer must be shaped again, 
+ * the password field depends on the authenticator field.
+ * @param server A pointer to the server.
+ * @param sock The socket of the server for the packet, if it is -1 the 
+ * socket is selected by the code of the packet.
+ * @param sign If it is false, the authenticator of an Accounting-Request 
+ * is not calculated, it must be done with signAccounting() before the packet is sent.
+ * @return The socket of the server which is used for the packet, 
+ * SHAPE_ERROR, SOCKET_ERROR or UNKNOWN_HOST in case of error.
+ */
+int RadiusPacket::radiusShape(RadiusServer *server, int sock, bool sign)
+{
+	if(this->shapeRadiusPacket(server->getCrypto())!=0)
 	{
 		return SHAPE_ERROR;
 	}
@@ -415,63 +757,273 @@ int RadiusPacket::radiusSend(list<RadiusServer>::iterator server)
 	//packet and the shared secret, if the packet is a ACCOUNTING_REQUEST
 	if (this->code==ACCOUNTING_REQUEST)
 	{
-		this->calcacctdigest(server->getSharedSecret().c_str());
-	
+		if (sign)
+		{
+			this->calcacctdigest(server->getCrypto());
+		}
+	}
+	else if (this->attribs.find(ATTRIB_Message_Authenticator)!=this->attribs.end() ||
+		this->findAttribute(ATTRIB_Message_Authenticator, NULL)>=0)
+	{
+		this->calcMessageAuthenticator(server->getCrypto());
 	}
 	
 	//save the authenticator field for packet authentication on receiving a packet
-	memcpy(this->authenticator, this->req_authenticator, 16);
-		
-	//	Get server IP address (no check if input is IP address or DNS name
-    if(!(h=gethostbyname(server->getName().c_str())))
+	memcpy(this->req_authenticator, this->sendbuffer+4, 16);
+	
+	//the ports are differnt for accounting and authentication
+	if (sock>=0)
 	{
-		return UNKNOWN_HOST;
+		this->sock=sock;
 	}
-    
-    remoteServAddr.sin_family=h->h_addrtype;
-    memcpy((char*)&(remoteServAddr.sin_addr.s_addr),h->h_addr_list[0],h->h_length);
-    
-    //set the port, they are differnt for accounting and authentication
-    if (this->code==ACCOUNTING_REQUEST)
+	else if (this->code==ACCOUNTING_REQUEST)
 	{
-    	remoteServAddr.sin_port=htons(server->getAcctPort());
+		this->sock=server->getAcctSocket();
 	}
 	else
 	{
-		remoteServAddr.sin_port=htons(server->getAuthPort());
+		this->sock=server->getAuthSocket();
 	}
-    
-    //	Socket creation
-    if((socket2Radius = socket(AF_INET, SOCK_DGRAM, 0))<0)
+	this->sentserver=&(*server);
+	return this->sock;
+}
+
+
+/** The method calculates the authenticators of Accounting-Requests which
+ * were shaped with radiusShape() without signing. The packets of the same server 
+ * are hashed together, see RadiusCrypto::digestBatch(). Other packets are skipped.
+ * @param packets An array of the packets.
+ * @param count The number of packets.
+ */
+void RadiusPacket::signAccounting(RadiusPacket **packets, int count)
+{
+	vector<const Octet *>	values(count);
+	vector<int>				lens(count);
+	vector<Octet *>			digests(count);
+	vector<bool>			done(count, false);
+	RadiusCrypto			*crypto;
+	int						i, j, n;
+	
+	for (i=0; i<count; i++)
+	{
+		if (done[i] || packets[i]->code!=ACCOUNTING_REQUEST || packets[i]->sentserver==NULL)
+		{
+			continue;
+		}
+		
+		//collect the packets with the same secret
+		crypto=packets[i]->sentserver->getCrypto();
+		n=0;
+		for (j=i; j<count; j++)
+		{
+			if (!done[j] && packets[j]->code==ACCOUNTING_REQUEST && packets[j]->sentserver!=NULL &&
+				packets[j]->sentserver->getCrypto()==crypto)
+			{
+				done[j]=true;
+				memset(packets[j]->sendbuffer+4, 0, 16);
+				values[n]=packets[j]->sendbuffer;
+				lens[n]=packets[j]->length;
+				digests[n]=packets[j]->sendbuffer+4;
+				n++;
+			}
+		}
+		crypto->digestBatch(n, &values[0], &lens[0], &digests[0]);
+		
+		for (j=i; j<count; j++)
+		{
+			if (packets[j]->code==ACCOUNTING_REQUEST && packets[j]->sentserver!=NULL &&
+				packets[j]->sentserver->getCrypto()==crypto)
+			{
+				memcpy(packets[j]->authenticator, packets[j]->sendbuffer+4, 16);
+				memcpy(packets[j]->req_authenticator, packets[j]->sendbuffer+4, 16);
+			}
+		}
+	}
+}
+
+/** The method sends the shaped packet over the socket
+ * of the server, it is used for retransmissions, too.
+ * @return Returns the number of bytes successfully sent or SOCKET_ERROR, 
+ * if the packet wasn't sent completely.
+ */
+int RadiusPacket::radiusTransmit(void)
+{
+	int result;
+	
+	if (this->sock<0 || this->sendbuffer==NULL)
 	{
-		cerr <<  "Cannot open socket: "<< strerror(errno) <<"\n";
 		return SOCKET_ERROR;
 	}
-    
-	//	Bind any port
-    cliAddr.sin_family=AF_INET;
-    cliAddr.sin_addr.s_addr=htonl(INADDR_ANY);
-    cliAddr.sin_port=htons(0);
- 	 	
-	//Bind the socket port,
-    if(bind(socket2Radius,(struct sockaddr*)&cliAddr,sizeof(struct sockaddr))<0)
+	//a pending ICMP error of an earlier packet is reported
+	//on the next call, so try it a second time, a broken
+	//stream must not raise SIGPIPE
+	result=send(this->sock,this->sendbuffer,this->sendbufferlen,MSG_NOSIGNAL);
+	if (result<0 && errno==ECONNREFUSED)
 	{
-		cerr << "Cannot bind port: " << strerror(errno) << "\n";
-		socket2Radius=-1;
-		return BIND_ERROR;
+		result=send(this->sock,this->sendbuffer,this->sendbufferlen,MSG_NOSIGNAL);
+	}
+	//a part of a packet breaks the framing of a stream
+	if (result>=0 && result!=this->sendbufferlen)
+	{
+		return SOCKET_ERROR;
+	}
+	return result;
+}
+
+
+/** The method gives the shaped packet, e.g. to queue it on
+ * a stream which can't be written now.
+ * @param buf A pointer to the buffer of the packet.
+ * @return The length of the packet or SOCKET_ERROR, if it is not shaped.
+ */
+int RadiusPacket::getSendBuffer(const Octet **buf)
+{
+	if (this->sendbuffer==NULL)
+	{
+		return SOCKET_ERROR;
+	}
+	*buf=this->sendbuffer;
+	return this->sendbufferlen;
+}
+
+
+/** The method takes a received datagram as the response of the packet.
+ * The response is authenticated with the shared secret of the server the packet
+ * was sent to, then the attributes are replaced by the attributes of 
+ * the response.
+ * @param buf The received datagram.
+ * @param len The length of the datagram.
+ * @return 0 if everything is ok, BAD_LENGTH, WRONG_AUTHENTICATOR_IN_RECV_PACKET 
+ * or UNSHAPE_ERROR in case of error.
+ */
+int RadiusPacket::radiusParseResponse(const Octet *buf, int len)
+{
+	if (len<20 || len>RADIUS_MAX_PACKET_LEN || this->sentserver==NULL)
+	{
+		return BAD_LENGTH;
+	}
+	if(this->recvbuffer==NULL && !(this->recvbuffer=new Octet[RADIUS_MAX_PACKET_LEN]))
+	{
+		return (ALLOC_ERROR);
+	}
+	memcpy(this->recvbuffer, buf, len);
+	this->recvbufferlen=len;
+	if (this->authenticateReceivedPacket(this->sentserver)!=0)
+	{
+		this->recvbufferlen=0;
+		return WRONG_AUTHENTICATOR_IN_RECV_PACKET;
 	}
 	
-	//safe the socket for receiving packets
-	this->sock=socket2Radius;
-	//sent the buffer
-	return sendto(socket2Radius,this->sendbuffer,this->sendbufferlen,0,(struct sockaddr*)&remoteServAddr,sizeof(struct sockaddr));
+	//clear the attributes, the attributes of the response are only validated
+	attribs.clear();
+	if(this->unShapeRadiusPacket()!=0)
+	{
+		this->recvbufferlen=0;
+		return UNSHAPE_ERROR;
+	}
+	return 0;
+}
+
+/** The method takes the response of another packet, which was a copy of
+ * this packet and was sent to another server. The code, the authenticator and 
+ * the attributes of the response are moved to this packet.
+ * @param p The packet with the parsed response.
+ */
+void RadiusPacket::takeResponse(RadiusPacket *p)
+{
+	Octet	*buffer=this->recvbuffer;
+	
+	this->code=p->code;
+	this->length=p->length;
+	memcpy(this->authenticator, p->authenticator, RADIUS_PACKET_AUTHENTICATOR_LEN);
+	this->attribs.swap(p->attribs);
+	p->attribs.clear();
+	
+	//the receive buffers are swapped, the attributes are not copied
+	this->recvbuffer=p->recvbuffer;
+	this->recvbufferlen=p->recvbufferlen;
+	this->recvattribs=p->recvattribs;
+	p->recvbuffer=buffer;
+	p->recvbufferlen=0;
+	p->recvattribs=false;
+}
+
+/** Waits for the response to the sent packet on the socket of the server.
+ * Datagrams with a wrong identifier or a wrong authenticator are 
+ * old responses or forged packets, they are dropped and the method waits 
+ * for the rest of the time.
+ * @param server The server the packet was sent to.
+ * @return 0 if a valid response is in the recvbuffer, NO_RESPONSE if the time
+ * is over or the server is unreachable, WRONG_AUTHENTICATOR_IN_RECV_PACKET if only
+ * packets with a wrong authenticator were received, ALLOC_ERROR.
+ */
+int RadiusPacket::recvRadiusPacket(RadiusServer *server)
+{
+	int				result, ret=NO_RESPONSE;
+	fd_set  		set;
+	struct timeval 	tv, now, end;
+	
+	gettimeofday(&end, NULL);
+	end.tv_sec+=server->getWait();
+	
+	//allocate enough space for the buffer (RFC says maximum 4096=RADIUS_MAX_PACKET_LEN Bytes)
+	if(this->recvbuffer==NULL && !(this->recvbuffer=new Octet[RADIUS_MAX_PACKET_LEN]))
+	{
+		return (ALLOC_ERROR);
+	}
+	
+	while (1)
+	{
+		gettimeofday(&now, NULL);
+		timersub(&end, &now, &tv);
+		if (tv.tv_sec<0)
+		{
+			return ret;
+		}
+		// wait for the rest of the time for a response
+		FD_ZERO(&set);				// clear out the set 
+		FD_SET(this->sock, &set);	// wait only for the RADIUS UDP socket 
+		result = select(this->sock+1, &set, NULL, NULL, &tv);
+		if (result<0 && errno==EINTR)
+		{
+			continue;
+		}
+		if (result<=0)
+		{
+			return ret;
+		}
+		
+		//read all datagrams which are in the queue
+		while ((this->recvbufferlen=recv(this->sock,this->recvbuffer,RADIUS_MAX_PACKET_LEN,0))>=0)
+		{
+			//the response must be at least as long as the header and must
+			//have the identifier of the request
+			if (this->recvbufferlen<20 || this->recvbuffer[1]!=this->identifier)
+			{
+				continue;
+			}
+			if (this->authenticateReceivedPacket(server)!=0)
+			{
+				ret=WRONG_AUTHENTICATOR_IN_RECV_PACKET;
+				continue;
+			}
+			return 0;
+		}
+		this->recvbufferlen=0;
+		//the server sent ICMP port unreachable 
+		if (errno==ECONNREFUSED)
+		{
+			return NO_RESPONSE;
+		}
+	}
 }
 
 
 /**	Receives a packet from a radius server, and copies it into recvbuffer.
  * If there is no response the packet is send again if the server->retry 
- * is bigger than 0. 1 means the packet is send
- * one more time. If a packet is received the received data is write to the recvbuffer
+ * is bigger than 1. 2 means the packet is send
+ * one more time. If the server doesn't answer, it is counted as a failure of the 
+ * server and the packet is sent to the next server in the list, which is not dead. If a packet is received the received data is write to the recvbuffer
  * and the length is written to recvbufferlen. 
  * The attributes are cleared if a packet is received.
  * @param serverlist : A list of radius server. 
@@ -482,104 +1034,68 @@ int RadiusPacket::radiusReceive(list<RadiusServer> *serverlist)
 	
 	list<RadiusServer>::iterator server;
 	
-	int 			result, retries=1; //for the first try retries=1, because the first packet was send in radiusSend()
-	socklen_t		len;
-	struct hostent	*h;
-	fd_set  		set; 
-	struct timeval 	tv;
-	struct sockaddr_in	remoteServAddr;
+	int 			result=NO_RESPONSE, retries;
 	int i_server=serverlist->size(),i=0;
-	server=serverlist->begin();
 	
-    int step = 0;
-
+	//start with the server the packet was sent to in radiusSend()
+	for (server=serverlist->begin(); server!=serverlist->end() && &(*server)!=this->sentserver; server++);
+	if (server==serverlist->end())
+	{
+		server=serverlist->begin();
+	}
+	
 	while (i<i_server)
-	{		
-        try
-        {
-		//	Get server IP address (no check if input is IP address or DNS name
-	    if(!(h=gethostbyname(server->getName().c_str())))
+	{
+		//the first packet was send in radiusSend()
+		for (retries=1; retries<=server->getRetry(); retries++)
 		{
-			return UNKNOWN_HOST;
-		}
-	    remoteServAddr.sin_family=h->h_addrtype;
-	    
-        remoteServAddr.sin_port=htons(server->getAuthPort());
-		
-		
-	    //retry the sending if there is no result
-        while (retries<=server->getRetry())
-	    {
-            step = 0;
-		    // wait for the specified time for a response
-		    tv.tv_sec = server->getWait();  
-		    tv.tv_usec = 0;
-		    FD_ZERO(&set);				// clear out the set 
-		    FD_SET(this->sock, &set);	// wait only for the RADIUS UDP socket 
-            step++;
-            result = select(FD_SETSIZE, &set, NULL, NULL, &tv);
-				
-			if (result>0)
+			//send the same packet again
+			if (retries>1 && this->radiusTransmit()<0)
+			{
+				break;
+			}
+			
+			result=this->recvRadiusPacket(&(*server));
+			if (result==0)
 			{
+				server->markResponse();
+				
 				//clear the attributes
 				attribs.clear();
 				
-				//allocate enough space for the buffer (RFC says maximum 4096=RADIUS_MAX_PACKET_LEN Bytes)
-                step++;
-                if(!(this->recvbuffer=new Octet[RADIUS_MAX_PACKET_LEN]))
-				{
-					return (ALLOC_ERROR);
-				}
-				//set the buffer to 0
-				memset(this->recvbuffer,0,RADIUS_MAX_PACKET_LEN); 	
-				len=sizeof(struct sockaddr_in);
-                step++;
-                this->recvbufferlen=recvfrom(this->sock,this->recvbuffer,RADIUS_MAX_PACKET_LEN,0,(struct sockaddr*)&remoteServAddr,&len);
-				close(this->sock);
-				this->sock=0;
 				//unshape the packet
-                step++;
-                if(this->unShapeRadiusPacket()!=0)
+				if(this->unShapeRadiusPacket()!=0)
 				{
 					return UNSHAPE_ERROR;
 				}
-				
-                step++;
-                if (this->authenticateReceivedPacket(server->getSharedSecret().c_str())!=0)
-				{
-					
-					return WRONG_AUTHENTICATOR_IN_RECV_PACKET;
-				}
 				return 0;
 			}
-			else
+			if (result==ALLOC_ERROR)
 			{
-				close(this->sock);
-				this->sock=0;
-				//retry only if the retries are less than
-				//the server retries
-				if(retries <= server->getRetry())
-				{
-                    step+=100;
-                    this->radiusSend(server);
-				}
+				return result;
 			}
-			retries++;
-	    }
-	    
-		server++;
+		}
+		
+		server->markFailure();
+		
+		//try the next server, dead servers are skipped
 		i++;
-		//set the retries=0, for the new server
-		retries=0;
-        }
-        catch(std::bad_alloc&)
-        {
-            cerr << "-------- RADIUS-PLUGIN: radiusReceive bad_alloc. (step = "<<step<< ")" << endl;
-            throw;
-        }
+		while (i<i_server)
+		{
+			server++;
+			if (server==serverlist->end())
+			{
+				server=serverlist->begin();
+			}
+			if (server->isAlive() && this->radiusSend(server)>=0)
+			{
+				break;
+			}
+			i++;
+		}
 	}
 	
-	return NO_RESPONSE;
+	return result;
   	
 }
 
@@ -589,11 +1105,10 @@ int RadiusPacket::radiusReceive(list<RadiusServer> *serverlist)
  * secret.
  * The authenticator is updated in the field this->authenticator
  * and in the serialized packet.
- * @param secret The shared secret of the server in plaintext.
+ * @param crypto The hash contexts of the shared secret.
  */
-void RadiusPacket::calcacctdigest(const char *secret)
+void RadiusPacket::calcacctdigest(RadiusCrypto *crypto)
 {
-	//Octet		digest[MD5_DIGEST_LENGTH];
 	gcry_md_hd_t	context;
 
 	//Zero out the auth_vector in the received packet.
@@ -602,30 +1117,59 @@ void RadiusPacket::calcacctdigest(const char *secret)
 	//as the original MD5 sum (packet->vector).
 	
 	memset((this->sendbuffer+4), 0, 16);
-	//build the hash	
-	if (!gcry_control (GCRYCTL_ANY_INITIALIZATION_P))
-	{ /* No other library has already initialized libgcrypt. */
-
-	  gcry_control(GCRYCTL_SET_THREAD_CBS,&gcry_threads_pthread);
-
-	  if (!gcry_check_version (NEED_LIBGCRYPT_VERSION) )
-	    {
-		cerr << "libgcrypt is too old (need " << NEED_LIBGCRYPT_VERSION << ", have " << gcry_check_version (NULL) << ")\n";
-	    }
-	    /* Disable secure memory.  */
-          gcry_control (GCRYCTL_DISABLE_SECMEM, 0);
-	  gcry_control (GCRYCTL_INITIALIZATION_FINISHED);
-	}
-	gcry_md_open (&context, GCRY_MD_MD5, 0);
+	//build the hash, the secret is at the end
+	context=crypto->startDigest();
 	gcry_md_write(context, this->sendbuffer, this->length);
-	gcry_md_write(context, secret, strlen(secret));
 	//copy the digest to the paket
-	memcpy(this->sendbuffer+4, gcry_md_read(context, GCRY_MD_MD5), 16);
+	crypto->finishDigest(context, this->sendbuffer+4);
 	memcpy(this->authenticator, this->sendbuffer+4, 16);
-	gcry_md_close(context);
 }
 
 
+/** The getter method of the packet identifier.
+ * @return The identifier as an integer.
+ */
+int	RadiusPacket::getIdentifier(void)
+{
+	return ((int)this->identifier);
+}
+
+/** The setter method of the packet identifier. It must 
+ * be set before the packet is shaped.
+ * @param id The new identifier.
+ */
+void RadiusPacket::setIdentifier(Octet id)
+{
+	this->identifier=id;
+}
+
+/** Calculates the value of the Message-Authenticator attribute (RFC 3579) 
+ * in the shaped packet. It is a HMAC-MD5 over the whole packet, the value of
+ * the attribute is set to 0 for the calculation. The shared secret is the key.
+ * @param crypto The hash contexts of the shared secret.
+ */
+void RadiusPacket::calcMessageAuthenticator(RadiusCrypto *crypto)
+{
+	int				pos=20;
+	
+	//find the attribute in the shaped packet
+	while (pos+2<=this->sendbufferlen && this->sendbuffer[pos]!=ATTRIB_Message_Authenticator)
+	{
+		if (this->sendbuffer[pos+1]<2)
+		{
+			return;
+		}
+		pos+=this->sendbuffer[pos+1];
+	}
+	if (pos+18>this->sendbufferlen || this->sendbuffer[pos+1]!=18)
+	{
+		return;
+	}
+	memset(this->sendbuffer+pos+2, 0, 16);
+	
+	crypto->calcHmac(this->sendbuffer, this->sendbufferlen, this->sendbuffer+pos+2);
+}
+
 /** Returns a pointer to the authenticator field.
  * @return A pointer to the authenticator field.
  */
@@ -642,25 +1186,6 @@ int	RadiusPacket::getCode(void)
 	return ((int)this->code);
 }
 
-/** Generates real random data with the device "/dev/random". 
- * Windows doesn'h have this device!. The method generates 
- * random data with the length len and copies it to the
- * field num. In the num field must be enough space!
- * @param len  The length of the random data.
- * @param num  A pointer to an array where the random data is written to.
- */
-void RadiusPacket::getRandom(int len, Octet *num)
-{
-
-  int fd = open("/dev/urandom",O_RDONLY); 
-  if (fd >= 0) 
-  {
-  	read(fd, num, len);		 
-  }
-  
-  close(fd);
-}
-
 /**The method finds attributes with the given type in the packet and returns iterator pair.
  * This can be looped for the attributes.
  * @param type The attribute type to find.
@@ -669,59 +1194,52 @@ void RadiusPacket::getRandom(int len, Octet *num)
 pair<multimap<Octet,RadiusAttribute>::iterator,multimap<Octet,RadiusAttribute>::iterator> RadiusPacket::findAttributes(int type)
 {
 	pair<multimap<Octet,RadiusAttribute>::iterator,multimap<Octet,RadiusAttribute>::iterator> p;
+	if (!this->recvattribs && this->recvbufferlen>0)
+	{
+		this->copyRecvAttributes();
+	}
 	p=attribs.equal_range((Octet) type);
 	return p;
 }
 
 /**The method checks the authenticator field from a received packet,
  * so the radius server is authenticated against the client.
- * @param secret The shared secret.
+ * @param server The server the packet was sent to.
  * @return A an integer, 0 if the authenticator field is ok, else WRONG_AUTHENTICATOR_IN_RECV_PACKET.
  */
 
-int	RadiusPacket::authenticateReceivedPacket(const char *secret)
+int	RadiusPacket::authenticateReceivedPacket(RadiusServer *server)
 {
 	gcry_md_hd_t	context;
+	Octet			digest[MD5_DIGEST_LENGTH];
+	int				len;
 	
-	Octet * cpy_recvpacket;
-	//make a copy of the received packet 
-	cpy_recvpacket=new Octet [this->recvbufferlen];
-	
-	memcpy(cpy_recvpacket, this->recvbuffer, this->recvbufferlen);
-	
-	//copy the authenticator of the sent packet to the received packet 
-	memcpy(cpy_recvpacket+4, this->sendbuffer+4, 16);
-	
-	//bulid the hash of the copy
-	//build the hash	
-	if (!gcry_control (GCRYCTL_ANY_INITIALIZATION_P))
-	{ /* No other library has already initialized libgcrypt. */
-
-	  gcry_control(GCRYCTL_SET_THREAD_CBS,&gcry_threads_pthread);
-
-	  if (!gcry_check_version (NEED_LIBGCRYPT_VERSION) )
-	    {
-		cerr << "libgcrypt is too old (need " << NEED_LIBGCRYPT_VERSION << ", have " << gcry_check_version (NULL) << ")\n";
-	    }
-	    /* Disable secure memory.  */
-          gcry_control (GCRYCTL_DISABLE_SECMEM, 0);
-	  gcry_control (GCRYCTL_INITIALIZATION_FINISHED);
+	//the hash is built over the length of the header, the rest is padding
+	if (this->recvbufferlen<20)
+	{
+		return WRONG_AUTHENTICATOR_IN_RECV_PACKET;
+	}
+	len=this->recvbuffer[2]*256+this->recvbuffer[3];
+	if (len<20 || len>this->recvbufferlen)
+	{
+		return WRONG_AUTHENTICATOR_IN_RECV_PACKET;
 	}
-	gcry_md_open (&context, GCRY_MD_MD5, 0);
-	gcry_md_write(context, cpy_recvpacket, this->recvbufferlen);
-	gcry_md_write(context, secret, strlen(secret));
 	
-	delete[] cpy_recvpacket;
+	//the hash is over the received packet with the authenticator of the 
+	//sent packet, the parts are hashed one after another without a copy
+	context=server->getCrypto()->startDigest();
+	gcry_md_write(context, this->recvbuffer, 4);
+	gcry_md_write(context, this->sendbuffer+4, 16);
+	gcry_md_write(context, this->recvbuffer+20, len-20);
+	server->getCrypto()->finishDigest(context, digest);
 	
 	//compare the received and the built authenticator
-	if (memcmp(this->recvbuffer+4, gcry_md_read(context, GCRY_MD_MD5), 16)!=0)
+	if (memcmp(this->recvbuffer+4, digest, 16)!=0)
 	{
-		gcry_md_close(context);
 		return WRONG_AUTHENTICATOR_IN_RECV_PACKET;
 	}
 	else
 	{ 
-		gcry_md_close(context);
 		return 0;
 	}
 		
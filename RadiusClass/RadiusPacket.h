@@ -35,6 +35,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/select.h>
+#include <sys/time.h>
 #include <time.h>
 #include <iostream>
 
@@ -42,15 +43,35 @@
 #include "radius.h"
 #include "RadiusAttribute.h"
 #include "RadiusServer.h"
+#include "RadiusRandom.h"
 
 
 #include <map>
 #include <list>
+#include <vector>
 #include <utility> 
 
 using namespace std;
 using std::multimap;
 
+/** The class is a view of an attribute of a received packet. The value
+ * is not copied, it points into the receive buffer of the packet, so the 
+ * view is only valid as long as the packet exists. See RadiusPacket::nextAttribute().*/
+class RadiusAttributeView
+{
+public:
+	Octet			type;		/**<The type of the attribute.*/
+	Octet			length;		/**<The length of the value.*/
+	unsigned short	offset;		/**<The offset of the value in the receive buffer, 0 before the first attribute.*/
+	const Octet		*value;		/**<A pointer to the value.*/
+	
+	RadiusAttributeView(void);
+	
+	int				intFromBuf(void);
+	string			ipFromBuf(void);
+	string			ip6FromBuf(void);
+};
+
 /** The class represents a radius packet with additional variables*/
 
 class RadiusPacket
@@ -58,7 +79,8 @@ class RadiusPacket
 private:
 	
 	multimap<Octet,RadiusAttribute> attribs; 	/**The multimap for the radius attributes.*/
-	int					sock; 					/**<The socket which is used.*/
+	int					sock; 					/**<The socket which is used, it belongs to the RadiusServer.*/
+	RadiusServer		*sentserver;			/**<The server the packet was sent to at last.*/
 	Octet				code; 					/**< The code of the packet, see the Radius RFC or radius.h*/
 	Octet				identifier; 			/**<The identifier of the packet, it is generated randomly.*/			
 	unsigned short int	length;					/**<The length of the packet on the network in bytes. */			
@@ -75,20 +97,45 @@ private:
 	int					sendbufferlen; 			/**<Length of the buffer.*/
 	Octet				*recvbuffer;  			/**<Buffer for recveing the packet over the network.*/
 	int					recvbufferlen; 			/**<Length of the buffer.*/
-	void            	calcacctdigest(const char *secret); /**Method to generate the hash 
+	bool				recvattribs;			/**<Is true if the attributes of the received packet are 
+	copied into the multimap, this is done only if findAttributes() is used.*/
+	Octet				flat[RADIUS_MAX_PACKET_LEN];	/**<The buffer of the packet builder, the attributes 
+	are appended in the network format and the buffer is sent without a copy.*/
+	int					flatlen;				/**<The length of the packet in flat, 0 if the builder is not used.*/
+	int					passwordpos;			/**<The offset of the User-Password value in flat, 0 if there is none.*/
+	Octet				password[RADIUS_MAX_PASSWORD_LEN];	/**<The padded plaintext password of the builder, 
+	it is hidden with the secret of the server on every shaping.*/
+	void            	calcacctdigest(RadiusCrypto *crypto); /**Method to generate the hash 
 	for the authenticator in Accounting-Requests.*/
+	void				calcMessageAuthenticator(RadiusCrypto *crypto); /**Method to generate the 
+	HMAC-MD5 of the Message-Authenticator attribute.*/
 	
 	//private functions
-	void 			getRandom(int len, Octet *num);
-	int				shapeRadiusPacket(const char *);
+	int				reserveAttribute(Octet type, int len);
+	int				shapeRadiusPacket(RadiusCrypto *);
 	int				unShapeRadiusPacket(void);
+	void			copyRecvAttributes(void);
+	int				recvRadiusPacket(RadiusServer *);
+	
+	RadiusPacket &	operator=(const RadiusPacket &);
 	
 public:
 					RadiusPacket(void);
 					~RadiusPacket(void);
 					RadiusPacket(Octet code);
+					RadiusPacket(const RadiusPacket &);
 					
 	int				addRadiusAttribute(RadiusAttribute *);
+	
+	int				appendAttribute(Octet type, const void *value, int len);
+	int				appendAttribute(Octet type, const char *value);
+	int				appendInteger(Octet type, uint32_t value);
+	int				appendIpAddress(Octet type, const char *value);
+	int				appendPassword(const char *value);
+	int				appendAttributes(const Octet *value, int len);
+	int				getAttributes(const Octet **value);
+	void			setInteger(int pos, uint32_t value);
+	int				findAttribute(Octet type, const Octet **value);
 		
 	void			dumpRadiusPacket(void);
 	void			dumpShapedRadiusPacket(void);
@@ -96,14 +143,25 @@ public:
 	int				radiusSend(list<RadiusServer>::iterator);
 	int				radiusReceive(list<RadiusServer> *);
 	
+	int				radiusShape(RadiusServer *, int sock=-1, bool sign=true);
+	static void		signAccounting(RadiusPacket **, int);
+	int				radiusTransmit(void);
+	int				getSendBuffer(const Octet **);
+	int				radiusParseResponse(const Octet *, int);
+	void			takeResponse(RadiusPacket *);
+	
 	int				getRadiusAttribNumber(void);
 	char *			getAuthenticator(void);
 	
 	int				getCode(void);
 	
-	int				authenticateReceivedPacket(const char *secret);
+	int				getIdentifier(void);
+	void			setIdentifier(Octet);
+	
+	int				authenticateReceivedPacket(RadiusServer *);
 	
 	pair<multimap<Octet,RadiusAttribute>::iterator,multimap<Octet,RadiusAttribute>::iterator> findAttributes(int type);
+	bool			nextAttribute(RadiusAttributeView *view, int type=-1);
 	
 };
 
@@ -0,0 +1,254 @@
+/*
+ *  RadiusClass -- An C++-Library for radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+
+#include "RadiusRandom.h"
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <iostream>
+#if defined(__linux__) || defined(__FreeBSD__)
+#include <sys/random.h>
+#define HAVE_GETRANDOM
+#endif
+
+using namespace std;
+
+/** The random state of a thread. It has no constructor, so it can be
+ * a thread local variable, all fields are 0 at the start of a thread.*/
+class RadiusRandomState
+{
+public:
+	Octet		buffer[RADIUS_RANDOM_BUFFER];	/**<The random octets.*/
+	int			pos;							/**<The first unused octet in buffer, the buffer is empty if it is RADIUS_RANDOM_BUFFER.*/
+	int			generation;						/**<The value of forkgeneration when the buffer was filled.*/
+	bool		filled;							/**<Is true if the buffer was filled once.*/
+	bool		seeded;							/**<Is true if the ChaCha20 key is set.*/
+	uint32_t	key[8];							/**<The key of the ChaCha20 generator.*/
+	uint64_t	counter;						/**<The block counter of the ChaCha20 generator.*/
+};
+
+volatile int RadiusRandom::forkgeneration=0;
+
+static __thread RadiusRandomState state;
+static pthread_once_t atforkonce=PTHREAD_ONCE_INIT;
+
+#define CHACHA_ROTL(x, n)	(((x) << (n)) | ((x) >> (32 - (n))))
+#define CHACHA_QR(a, b, c, d) \
+	a += b; d ^= a; d = CHACHA_ROTL(d, 16); \
+	c += d; b ^= c; b = CHACHA_ROTL(b, 12); \
+	a += b; d ^= a; d = CHACHA_ROTL(d, 8); \
+	c += d; b ^= c; b = CHACHA_ROTL(b, 7);
+
+/** The function calculates a block of ChaCha20 (RFC 7539) with
+ * a nonce of 0.
+ * @param key The key of 8 words.
+ * @param counter The block counter.
+ * @param out An array of 64 octets for the block.
+ */
+static void chachaBlock(const uint32_t *key, uint64_t counter, Octet *out)
+{
+	uint32_t	in[16], x[16];
+	int			i;
+	
+	in[0]=0x61707865;
+	in[1]=0x3320646e;
+	in[2]=0x79622d32;
+	in[3]=0x6b206574;
+	for (i=0; i<8; i++)
+	{
+		in[4+i]=key[i];
+	}
+	in[12]=(uint32_t)counter;
+	in[13]=(uint32_t)(counter>>32);
+	in[14]=0;
+	in[15]=0;
+	
+	memcpy(x, in, sizeof(x));
+	for (i=0; i<10; i++)
+	{
+		CHACHA_QR(x[0], x[4], x[8], x[12])
+		CHACHA_QR(x[1], x[5], x[9], x[13])
+		CHACHA_QR(x[2], x[6], x[10], x[14])
+		CHACHA_QR(x[3], x[7], x[11], x[15])
+		CHACHA_QR(x[0], x[5], x[10], x[15])
+		CHACHA_QR(x[1], x[6], x[11], x[12])
+		CHACHA_QR(x[2], x[7], x[8], x[13])
+		CHACHA_QR(x[3], x[4], x[9], x[14])
+	}
+	for (i=0; i<16; i++)
+	{
+		x[i]+=in[i];
+		out[4*i]=(Octet)x[i];
+		out[4*i+1]=(Octet)(x[i]>>8);
+		out[4*i+2]=(Octet)(x[i]>>16);
+		out[4*i+3]=(Octet)(x[i]>>24);
+	}
+}
+
+/** The function reads random octets from the kernel.
+ * @param value An array for the octets.
+ * @param len The number of octets.
+ * @return True if all octets were read.
+ */
+static bool kernelRandom(Octet *value, int len)
+{
+	int		fd, n, done=0;
+	
+#if defined(HAVE_GETRANDOM)
+	while (done<len)
+	{
+		n=getrandom(value+done, len-done, 0);
+		if (n<0 && errno==EINTR)
+		{
+			continue;
+		}
+		if (n<=0)
+		{
+			break;
+		}
+		done+=n;
+	}
+	if (done==len)
+	{
+		return true;
+	}
+	done=0;
+#endif
+	if ((fd=open("/dev/urandom", O_RDONLY))<0)
+	{
+		return false;
+	}
+	while (done<len)
+	{
+		n=read(fd, value+done, len-done);
+		if (n<0 && errno==EINTR)
+		{
+			continue;
+		}
+		if (n<=0)
+		{
+			break;
+		}
+		done+=n;
+	}
+	close(fd);
+	return done==len;
+}
+
+/** The method is called in the child after a fork, the
+ * buffers and the keys of the parent are not used any more.
+ */
+void RadiusRandom::atFork(void)
+{
+	forkgeneration++;
+}
+
+/** The method registers atFork(), it is called once.
+ */
+void RadiusRandom::registerAtFork(void)
+{
+	pthread_atfork(NULL, NULL, RadiusRandom::atFork);
+}
+
+/** The method fills the buffer of the thread with getrandom(). If it 
+ * fails, the buffer is filled by ChaCha20. The first output of ChaCha20 is 
+ * the next key, so the octets of the buffer can't be calculated back.
+ */
+void RadiusRandom::refill(void)
+{
+	Octet			block[64], seed[32];
+	struct timeval	now;
+	int				i;
+	
+	pthread_once(&atforkonce, RadiusRandom::registerAtFork);
+	if (state.generation!=forkgeneration)
+	{
+		state.seeded=false;
+		state.generation=forkgeneration;
+	}
+	state.pos=0;
+	state.filled=true;
+	
+#if defined(HAVE_GETRANDOM)
+	if (getrandom(state.buffer, RADIUS_RANDOM_BUFFER, 0)==RADIUS_RANDOM_BUFFER)
+	{
+		return;
+	}
+#endif
+	
+	if (!state.seeded)
+	{
+		if (!kernelRandom(seed, sizeof(seed)))
+		{
+			cerr << "RADIUS-CLASS: No random device, the random numbers are seeded with the time.\n";
+			memset(seed, 0, sizeof(seed));
+			gettimeofday(&now, NULL);
+			memcpy(seed, &now, sizeof(now)<16 ? sizeof(now) : 16);
+			i=getpid();
+			memcpy(seed+16, &i, sizeof(i));
+			i=(int)clock();
+			memcpy(seed+20, &i, sizeof(i));
+		}
+		memcpy(state.key, seed, sizeof(state.key));
+		memset(seed, 0, sizeof(seed));
+		state.counter=0;
+		state.seeded=true;
+	}
+	
+	chachaBlock(state.key, state.counter++, block);
+	memcpy(state.key, block, sizeof(state.key));
+	for (i=0; i<RADIUS_RANDOM_BUFFER; i+=64)
+	{
+		chachaBlock(state.key, state.counter++, block);
+		memcpy(state.buffer+i, block, RADIUS_RANDOM_BUFFER-i<64 ? RADIUS_RANDOM_BUFFER-i : 64);
+	}
+	memset(block, 0, sizeof(block));
+}
+
+/** The method copies random octets from the buffer of the thread,
+ * the buffer is filled again if it is empty. The octets are erased
+ * in the buffer.
+ * @param value An array for the random octets.
+ * @param len The number of octets.
+ */
+void RadiusRandom::getBytes(Octet *value, int len)
+{
+	int n;
+	
+	while (len>0)
+	{
+		if (!state.filled || state.pos>=RADIUS_RANDOM_BUFFER || state.generation!=forkgeneration)
+		{
+			refill();
+		}
+		n=RADIUS_RANDOM_BUFFER-state.pos<len ? RADIUS_RANDOM_BUFFER-state.pos : len;
+		memcpy(value, state.buffer+state.pos, n);
+		memset(state.buffer+state.pos, 0, n);
+		state.pos+=n;
+		value+=n;
+		len-=n;
+	}
+}
@@ -0,0 +1,52 @@
+/*
+ *  RadiusClass -- An C++-Library for radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+
+#ifndef _RADIUSRANDOM_H_
+#define _RADIUSRANDOM_H_
+
+#include <stdint.h>
+#include "radius.h"
+
+/** The number of random octets which are buffered per thread.*/
+#define RADIUS_RANDOM_BUFFER	256
+
+/** The class generates the random numbers for the identifiers, the 
+ * authenticators and the session ids. Every thread has a buffer which is 
+ * filled with getrandom(), so there is one system call for many packets.
+ * If getrandom() is not available or fails, the buffer is filled by a ChaCha20
+ * generator, which is seeded once from /dev/urandom and gets a new key 
+ * after every refill. The buffers are dropped in a forked child, so
+ * the processes don't share random numbers.*/
+class RadiusRandom
+{
+private:
+	static volatile int	forkgeneration;	/**<It is incremented in a forked child.*/
+	
+	static void		atFork(void);
+	static void		registerAtFork(void);
+	static void		refill(void);
+	
+public:
+	static void		getBytes(Octet *value, int len);
+};
+
+#endif //_RADIUSRANDOM_H_
@@ -20,7 +20,16 @@
  */
  
 #include "RadiusServer.h"
+#include "error.h"
 #include <string.h>
+#include <algorithm>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/un.h>
+#include <sys/types.h>
+#include <sys/socket.h>
 
 
 /** The constructer of the class.
@@ -39,39 +48,583 @@ RadiusServer::RadiusServer(string name, string secret,
 	this->name=name;
 	this->retry=retry;
 	this->wait=wait;
+	this->transport=RADIUS_TRANSPORT_UDP;
 	this->sharedsecret=secret;
-	
-	
+	this->crypto.setSecret(secret);
+	this->authsock=-1;
+	this->acctsock=-1;
+	this->resolved=false;
+	this->numeric=false;
+	this->refresherstarted=false;
+	this->refreshing=false;
+	this->resolvettl=300;
+	this->maxfails=1;
+	this->deadtime=30;
+	this->statusserver=false;
+	this->weight=1;
+	this->rtomin=200;
+	this->rtomax=60000;
+	this->fails=0;
+	this->deadcount=0;
+	this->deaduntil=0;
+	this->probing=false;
+	this->currentweight=0;
+	this->outstanding=0;
+	this->srtt=0;
+	this->rttvar=0;
+	this->latencycount=0;
+	this->latencynext=0;
+	pthread_mutex_init(&this->mutex, NULL);
+}
+
+/** The copy constructor of the class.
+ * The sockets, the address cache, the health, the balancing state and the round trip time are not shared with the copy, 
+ * it opens its own sockets when they are used the first time.
+ * @param const RadiusServer &s : A reference to a RadiusServer.
+ */
+RadiusServer::RadiusServer(const RadiusServer &s)
+{
+	this->name=s.name;
+	this->wait=s.wait;
+	this->retry=s.retry;
+	this->transport=s.transport;
+	this->acctport=s.acctport;
+	this->authport=s.authport;
+	this->sharedsecret=s.sharedsecret;
+	this->crypto.setSecret(s.sharedsecret);
+	this->authsock=-1;
+	this->acctsock=-1;
+	this->resolved=false;
+	this->numeric=false;
+	this->refresherstarted=false;
+	this->refreshing=false;
+	this->resolvettl=s.resolvettl;
+	this->maxfails=s.maxfails;
+	this->deadtime=s.deadtime;
+	this->statusserver=s.statusserver;
+	this->weight=s.weight;
+	this->rtomin=s.rtomin;
+	this->rtomax=s.rtomax;
+	this->fails=0;
+	this->deadcount=0;
+	this->deaduntil=0;
+	this->probing=false;
+	this->currentweight=0;
+	this->outstanding=0;
+	this->srtt=0;
+	this->rttvar=0;
+	this->latencycount=0;
+	this->latencynext=0;
+	pthread_mutex_init(&this->mutex, NULL);
 }
 
 /** The destructur of the class.
- * It does nothing.
+ * It waits for the refresher and closes the sockets.
  */
 RadiusServer::~RadiusServer()
 {
-	
+	this->joinRefresh();
+	this->closeSockets();
+	pthread_mutex_destroy(&this->mutex);
 }
 
 /** The allocation operator.
+ * The open sockets of the server are closed, the sockets
+ * of s are not copied.
  * @param const RadiusServer &s : A reference to a RadiusServer.
 */
 RadiusServer &RadiusServer::operator=(const RadiusServer &s)
 {
+	if (this==&s)
+	{
+		return (*this);
+	}
+	this->joinRefresh();
+	this->closeSockets();
+	this->resolved=false;
 	this->name=s.name;
 	this->wait=s.wait;
 	this->retry=s.retry;
+	this->transport=s.transport;
 	this->acctport=s.acctport;
 	this->authport=s.authport;
 	this->sharedsecret=s.sharedsecret;
+	this->crypto.setSecret(s.sharedsecret);
+	this->resolvettl=s.resolvettl;
+	this->maxfails=s.maxfails;
+	this->deadtime=s.deadtime;
+	this->statusserver=s.statusserver;
+	this->weight=s.weight;
+	this->rtomin=s.rtomin;
+	this->rtomax=s.rtomax;
+	this->fails=0;
+	this->deadcount=0;
+	this->deaduntil=0;
+	this->probing=false;
+	this->currentweight=0;
+	this->outstanding=0;
+	this->srtt=0;
+	this->rttvar=0;
+	this->latencycount=0;
+	this->latencynext=0;
 	return (*this);
 }
 
+volatile sig_atomic_t RadiusServer::resolvegeneration=0;
+
+/** The method marks the cached addresses of all servers as expired, 
+ * the names are resolved again in the background when the next packet is sent. 
+ * It is safe to call it from a signal handler.
+ */
+void RadiusServer::expireAddresses(void)
+{
+	resolvegeneration=resolvegeneration+1;
+}
+
+/** The method checks if the cached address must be resolved again.
+ * Ip addresses are never resolved again.
+ * @return true if the address must be resolved.
+ */
+bool RadiusServer::addressExpired(void)
+{
+	if (!this->resolved)
+	{
+		return true;
+	}
+	if (this->numeric)
+	{
+		return false;
+	}
+	if (this->generation!=resolvegeneration)
+	{
+		return true;
+	}
+	return (this->resolvettl>0 && time(NULL)-this->resolvetime>=this->resolvettl);
+}
+
+/** The method resolves a name with getaddrinfo(), it may block. 
+ * It doesn't use the server, so the mutex must not be locked.
+ * @param name The name or the ip address.
+ * @param addr The address, the port is not set.
+ * @param addrlen The length of the address.
+ * @return 0 if everything is ok, else UNKNOWN_HOST.
+ */
+int RadiusServer::lookupAddress(const string &name, struct sockaddr_storage *addr, socklen_t *addrlen)
+{
+	struct addrinfo hints, *res;
+	
+	memset(&hints,0,sizeof(hints));
+	hints.ai_family=AF_UNSPEC;
+	hints.ai_socktype=SOCK_DGRAM;
+	hints.ai_flags=AI_ADDRCONFIG;
+	
+	if (getaddrinfo(name.c_str(), NULL, &hints, &res)!=0 || res==NULL)
+	{
+		cerr << "Cannot resolve " << name << ".\n";
+		return UNKNOWN_HOST;
+	}
+	memcpy(addr,res->ai_addr,res->ai_addrlen);
+	*addrlen=res->ai_addrlen;
+	freeaddrinfo(res);
+	return 0;
+}
+
+/** The method resolves the name of the server the first time, it blocks 
+ * until the name is resolved. The address is saved for all following packets, 
+ * after the ttl it is resolved again by startRefresh().
+ * The mutex must be locked.
+ * @return 0 if everything is ok, else UNKNOWN_HOST.
+ */
+int RadiusServer::resolveAddress(void)
+{
+	struct addrinfo hints, *res;
+	
+	this->resolvetime=time(NULL);
+	this->generation=resolvegeneration;
+	
+	if (lookupAddress(this->name, &this->addr, &this->addrlen)!=0)
+	{
+		return UNKNOWN_HOST;
+	}
+	
+	//ip addresses are never resolved again
+	memset(&hints,0,sizeof(hints));
+	hints.ai_family=AF_UNSPEC;
+	hints.ai_socktype=SOCK_DGRAM;
+	hints.ai_flags=AI_NUMERICHOST;
+	this->numeric=false;
+	if (getaddrinfo(this->name.c_str(), NULL, &hints, &res)==0)
+	{
+		this->numeric=true;
+		freeaddrinfo(res);
+	}
+	this->resolved=true;
+	return 0;
+}
+
+/** The method saves a new address of the server. If the address has changed, the
+ * open sockets are connected to the new address or, if that is not possible, 
+ * marked as stale. The mutex must be locked.
+ * @param addr The address.
+ * @param addrlen The length of the address.
+ */
+void RadiusServer::setAddress(const struct sockaddr_storage *addr, socklen_t addrlen)
+{
+	int family;
+	
+	if (addrlen==this->addrlen && memcmp(addr,&this->addr,addrlen)==0)
+	{
+		return;
+	}
+	family=this->addr.ss_family;
+	memcpy(&this->addr,addr,addrlen);
+	this->addrlen=addrlen;
+	//a socket can only be connected to an address of its family,
+	//a stream socket can't be connected again
+	if (family!=this->addr.ss_family || this->transport!=RADIUS_TRANSPORT_UDP)
+	{
+		this->staleSockets();
+	}
+	else
+	{
+		if (this->authsock>=0)
+		{
+			this->connectSocket(this->authsock,this->authport);
+		}
+		if (this->acctsock>=0)
+		{
+			this->connectSocket(this->acctsock,this->acctport);
+		}
+	}
+}
+
+/** The method marks the open sockets as stale, the next packets get new sockets.
+ * The stale sockets are not closed here, because the RadiusClient has requests
+ * on them, it takes them with takeStaleSocket(). The mutex must be locked.
+ */
+void RadiusServer::staleSockets(void)
+{
+	if (this->authsock>=0)
+	{
+		this->stalesockets.push_back(this->authsock);
+		this->authsock=-1;
+	}
+	if (this->acctsock>=0)
+	{
+		this->stalesockets.push_back(this->acctsock);
+		this->acctsock=-1;
+	}
+}
+
+/** The method starts the refresher, a thread which resolves the expired address
+ * again, so the packets never wait for the resolver. Until the name is resolved, 
+ * the cached address is used. If the name can't be resolved, the cached address
+ * is used until the ttl is over again. The mutex must be locked.
+ */
+void RadiusServer::startRefresh(void)
+{
+	if (this->refreshing)
+	{
+		return;
+	}
+	//the last refresher has finished
+	if (this->refresherstarted)
+	{
+		pthread_join(this->refresher, NULL);
+		this->refresherstarted=false;
+	}
+	this->resolvetime=time(NULL);
+	this->generation=resolvegeneration;
+	if (pthread_create(&this->refresher, NULL, &RadiusServer::refreshAddress, this)!=0)
+	{
+		cerr << "Cannot start the resolver thread for " << this->name << ".\n";
+		return;
+	}
+	this->refresherstarted=true;
+	this->refreshing=true;
+}
+
+/** The method waits for the refresher, e.g. before the server is destroyed.
+ * The mutex must not be locked.
+ */
+void RadiusServer::joinRefresh(void)
+{
+	if (this->refresherstarted)
+	{
+		pthread_join(this->refresher, NULL);
+		this->refresherstarted=false;
+		this->refreshing=false;
+	}
+}
+
+/** The function of the refresher thread, it resolves the name without
+ * the mutex and saves the new address.
+ * @param arg A pointer to the server.
+ * @return NULL.
+ */
+void * RadiusServer::refreshAddress(void *arg)
+{
+	RadiusServer *server=(RadiusServer *) arg;
+	struct sockaddr_storage addr;
+	socklen_t addrlen;
+	string name;
+	int ret;
+	
+	pthread_mutex_lock(&server->mutex);
+	name=server->name;
+	pthread_mutex_unlock(&server->mutex);
+	
+	ret=lookupAddress(name, &addr, &addrlen);
+	
+	pthread_mutex_lock(&server->mutex);
+	if (ret==0)
+	{
+		server->setAddress(&addr, addrlen);
+	}
+	server->refreshing=false;
+	pthread_mutex_unlock(&server->mutex);
+	return NULL;
+}
+
+/** The method connects a socket to the cached address and the given port.
+ * Because the socket is connected the kernel drops datagrams from other sources.
+ * @param sock The socket.
+ * @param port The destination port.
+ * @return 0 if everything is ok, else SOCKET_ERROR.
+ */
+int RadiusServer::connectSocket(int sock, short int port)
+{
+	struct sockaddr_storage servaddr;
+	
+	memcpy(&servaddr,&this->addr,this->addrlen);
+	if (servaddr.ss_family==AF_INET6)
+	{
+		((struct sockaddr_in6 *)&servaddr)->sin6_port=htons(port);
+	}
+	else
+	{
+		((struct sockaddr_in *)&servaddr)->sin_port=htons(port);
+	}
+	if (connect(sock,(struct sockaddr*)&servaddr,this->addrlen)<0)
+	{
+		cerr << "Cannot connect socket: " << strerror(errno) << "\n";
+		return SOCKET_ERROR;
+	}
+	return 0;
+}
+
+/** The method opens a socket which is connected to the server
+ * and the given port. A UDP socket is non blocking, so the caller
+ * must wait with select() for responses. A stream socket is connected
+ * in the wait time of the server, it blocks on sending for up to the wait time, so 
+ * a packet is always sent completely. The mutex must be locked.
+ * @param port The destination port.
+ * @return The socket, UNKNOWN_HOST or SOCKET_ERROR in case of error.
+ */
+int RadiusServer::openSocket(short int port)
+{
+	int sock;
+	
+	if (this->transport!=RADIUS_TRANSPORT_UDP)
+	{
+		return this->openStream(port);
+	}
+	if((sock=socket(this->addr.ss_family, SOCK_DGRAM, 0))<0)
+	{
+		cerr <<  "Cannot open socket: "<< strerror(errno) <<"\n";
+		return SOCKET_ERROR;
+	}
+	fcntl(sock, F_SETFD, FD_CLOEXEC);
+	fcntl(sock, F_SETFL, fcntl(sock, F_GETFL)|O_NONBLOCK);
+	
+	if (this->connectSocket(sock,port)!=0)
+	{
+		close(sock);
+		return SOCKET_ERROR;
+	}
+	return sock;
+}
+
+/** The method opens a TCP or Unix stream socket to the server. 
+ * The socket is not blocking and the connect may not be finished yet.
+ * The mutex must be locked.
+ * @param port The destination port, it is not used for Unix sockets.
+ * @return The socket or SOCKET_ERROR in case of error.
+ */
+int RadiusServer::openStream(short int port)
+{
+	struct sockaddr_storage servaddr;
+	struct sockaddr_un *sun;
+	socklen_t len;
+	int sock;
+	
+	memset(&servaddr,0,sizeof(servaddr));
+	if (this->transport==RADIUS_TRANSPORT_UNIX)
+	{
+		sun=(struct sockaddr_un *)&servaddr;
+		if (this->name.size()>=sizeof(sun->sun_path))
+		{
+			cerr << "The path " << this->name << " is too long.\n";
+			return SOCKET_ERROR;
+		}
+		sun->sun_family=AF_UNIX;
+		strcpy(sun->sun_path,this->name.c_str());
+		len=sizeof(struct sockaddr_un);
+	}
+	else
+	{
+		memcpy(&servaddr,&this->addr,this->addrlen);
+		if (servaddr.ss_family==AF_INET6)
+		{
+			((struct sockaddr_in6 *)&servaddr)->sin6_port=htons(port);
+		}
+		else
+		{
+			((struct sockaddr_in *)&servaddr)->sin_port=htons(port);
+		}
+		len=this->addrlen;
+	}
+	
+	if((sock=socket(servaddr.ss_family, SOCK_STREAM, 0))<0)
+	{
+		cerr <<  "Cannot open socket: "<< strerror(errno) <<"\n";
+		return SOCKET_ERROR;
+	}
+	fcntl(sock, F_SETFD, FD_CLOEXEC);
+	
+	//the connect is finished in the event loop of the RadiusClient,
+	//the stream gets writable when it is connected
+	fcntl(sock, F_SETFL, fcntl(sock, F_GETFL)|O_NONBLOCK);
+	if (connect(sock,(struct sockaddr*)&servaddr,len)<0 && errno!=EINPROGRESS)
+	{
+		cerr << "Cannot connect socket to " << this->name << ": " << strerror(errno) << "\n";
+		close(sock);
+		return SOCKET_ERROR;
+	}
+	return sock;
+}
+
+/** The method returns a socket of the server. The name is resolved
+ * on the first call, later the cached address is used and an expired address
+ * is resolved in the background. The socket is opened if it is not open.
+ * @param sock A pointer to the socket member.
+ * @param port The destination port of the socket.
+ * @return The socket, UNKNOWN_HOST or SOCKET_ERROR in case of error.
+ */
+int RadiusServer::getSocket(int *sock, short int port)
+{
+	int ret;
+	
+	pthread_mutex_lock(&this->mutex);
+	if (this->transport!=RADIUS_TRANSPORT_UNIX && !this->resolved && (ret=this->resolveAddress())!=0)
+	{
+		pthread_mutex_unlock(&this->mutex);
+		return ret;
+	}
+	if (this->transport!=RADIUS_TRANSPORT_UNIX && this->addressExpired())
+	{
+		this->startRefresh();
+	}
+	if (*sock<0)
+	{
+		*sock=this->openSocket(port);
+	}
+	ret=*sock;
+	pthread_mutex_unlock(&this->mutex);
+	return ret;
+}
+
+/** The getter method for the authentication socket.
+ * The socket is opened on the first call and kept open
+ * for all following packets.
+ * @return The socket, UNKNOWN_HOST or SOCKET_ERROR in case of error.
+ */
+int RadiusServer::getAuthSocket(void)
+{
+	return this->getSocket(&this->authsock,this->authport);
+}
+
+/** The getter method for the accounting socket.
+ * The socket is opened on the first call and kept open
+ * for all following packets.
+ * @return The socket, UNKNOWN_HOST or SOCKET_ERROR in case of error.
+ */
+int RadiusServer::getAcctSocket(void)
+{
+	return this->getSocket(&this->acctsock,this->acctport);
+}
+
+/** The method closes the sockets of the server, the stale sockets, too. They are
+ * opened again on the next use.
+ */
+void RadiusServer::closeSockets(void)
+{
+	for (unsigned int i=0; i<this->stalesockets.size(); i++)
+	{
+		close(this->stalesockets[i]);
+	}
+	this->stalesockets.clear();
+	if (this->authsock>=0)
+	{
+		close(this->authsock);
+		this->authsock=-1;
+	}
+	if (this->acctsock>=0)
+	{
+		close(this->acctsock);
+		this->acctsock=-1;
+	}
+}
+
+/** The method releases one socket of the server, e.g. a broken stream or a stale socket.
+ * The caller must close the socket, the server opens a new one on the next use.
+ * @param sock The socket.
+ */
+void RadiusServer::releaseSocket(int sock)
+{
+	vector<int>::iterator it;
+	
+	pthread_mutex_lock(&this->mutex);
+	if ((it=find(this->stalesockets.begin(), this->stalesockets.end(), sock))!=this->stalesockets.end())
+	{
+		this->stalesockets.erase(it);
+	}
+	if (sock>=0 && this->authsock==sock)
+	{
+		this->authsock=-1;
+	}
+	if (sock>=0 && this->acctsock==sock)
+	{
+		this->acctsock=-1;
+	}
+	pthread_mutex_unlock(&this->mutex);
+}
+
+/** The method takes a stale socket of the server, the caller must close it
+ * with its requests, see RadiusClient::closeStream().
+ * @return The socket or -1 if there is no stale socket.
+ */
+int RadiusServer::takeStaleSocket(void)
+{
+	int sock=-1;
+	
+	pthread_mutex_lock(&this->mutex);
+	if (!this->stalesockets.empty())
+	{
+		sock=this->stalesockets.back();
+		this->stalesockets.pop_back();
+	}
+	pthread_mutex_unlock(&this->mutex);
+	return sock;
+}
+
 /** The setter method for the authport.
  * There is no correctness checking.
  *@param port The number of the UDP port.
  */
 void RadiusServer::setAuthPort(short int port)
 {
+	this->closeSockets();
 	this->authport=port;
 }
 
@@ -90,6 +643,7 @@ int RadiusServer::getAuthPort()
  */
 void RadiusServer::setAcctPort(short int port)
 {
+	this->closeSockets();
 	this->acctport=port;
 }
 
@@ -109,10 +663,45 @@ int RadiusServer::getAcctPort()
  */
 void RadiusServer::setName(string name)
 {
+	this->joinRefresh();
+	this->closeSockets();
+	this->resolved=false;
+	this->numeric=false;
 	this->name=name;
 }
 
 
+/** The getter method for the transport.
+ * @return The transport, see RADIUS_TRANSPORT_*.
+ */
+int RadiusServer::getTransport(void)
+{
+	return this->transport;
+}
+
+/** The setter method for the transport. The open sockets are closed.
+ * @param t The transport, see RADIUS_TRANSPORT_*.
+ */
+void RadiusServer::setTransport(int t)
+{
+	this->closeSockets();
+	this->transport=t;
+}
+
+/** The setter method for the transport with the name from
+ * the config file.
+ * @param name One of udp, tcp or unix.
+ * @return 0 if the name is known, else PARSING_ERROR.
+ */
+int RadiusServer::setTransport(string name)
+{
+	if (name=="udp") this->setTransport(RADIUS_TRANSPORT_UDP);
+	else if (name=="tcp") this->setTransport(RADIUS_TRANSPORT_TCP);
+	else if (name=="unix") this->setTransport(RADIUS_TRANSPORT_UNIX);
+	else return PARSING_ERROR;
+	return 0;
+}
+
 /** The getter method for the server name.
  * @return A string with the server name.
  */
@@ -151,6 +740,7 @@ int RadiusServer::getRetry()
 void RadiusServer::setSharedSecret(string secret)
 {
 	this->sharedsecret=secret;
+	this->crypto.setSecret(secret);
 }
 
 /** The getter method for the  sharedsecret
@@ -161,6 +751,14 @@ string RadiusServer::getSharedSecret(void)
 	return this->sharedsecret;
 }
 
+/** The getter method for the hash contexts of the shared secret.
+ * @return A pointer to the contexts.
+ */
+RadiusCrypto * RadiusServer::getCrypto(void)
+{
+	return &(this->crypto);
+}
+
 
 /** The getter method for the private member wait*
  * @return A interger of the time to wait for a resopnse.
@@ -186,6 +784,349 @@ void RadiusServer::setWait(int w)
 	}
 }
 
+/** The getter method for the time the address of the server is cached.
+ * @return The time in seconds, 0 means forever.
+ */
+int RadiusServer::getResolveTtl(void)
+{
+	return this->resolvettl;
+}
+
+/** The setter method for the time the address of the server is cached.
+ * @param ttl The time in seconds, 0 means the name is resolved only once.
+ * If ttl is less than 0 it is set to 0.
+ */
+void RadiusServer::setResolveTtl(int ttl)
+{
+	if (ttl<0)
+	{
+		ttl=0;
+	}
+	this->resolvettl=ttl;
+}
+
+/** The getter method for the number of failed requests after which
+ * the server is marked as dead.
+ * @return The number of requests.
+ */
+int RadiusServer::getMaxFails(void)
+{
+	return this->maxfails;
+}
+
+/** The setter method for the number of failed requests after which
+ * the server is marked as dead.
+ * @param n The number of requests, if it is less than 1 it is set to 1.
+ */
+void RadiusServer::setMaxFails(int n)
+{
+	if (n<1)
+	{
+		n=1;
+	}
+	this->maxfails=n;
+}
+
+/** The getter method for the time a server is marked as dead.
+ * @return The time in seconds.
+ */
+int RadiusServer::getDeadTime(void)
+{
+	return this->deadtime;
+}
+
+/** The setter method for the time a server is marked as dead. 
+ * The time is doubled every time the server fails again, up to 32 times the value.
+ * @param t The time in seconds, if it is less than 1 it is set to 1.
+ */
+void RadiusServer::setDeadTime(int t)
+{
+	if (t<1)
+	{
+		t=1;
+	}
+	this->deadtime=t;
+}
+
+/** The getter method for the Status-Server probes.
+ * @return true if the server is probed when it is dead.
+ */
+bool RadiusServer::getStatusServer(void)
+{
+	return this->statusserver;
+}
+
+/** The setter method for the Status-Server probes (RFC 5997). A dead
+ * server which is probed is not used until a probe is answered. A dead server 
+ * which isn't probed is used again when the dead time is over.
+ * @param b true if the server is probed.
+ */
+void RadiusServer::setStatusServer(bool b)
+{
+	this->statusserver=b;
+}
+
+/** The method checks if the server can be used for requests.
+ * @return true if the server isn't marked as dead or the dead time is over 
+ * and the server isn't probed.
+ */
+bool RadiusServer::isAlive(void)
+{
+	if (this->deadcount==0)
+	{
+		return true;
+	}
+	return (!this->statusserver && time(NULL)>=this->deaduntil);
+}
+
+/** The method checks if a Status-Server probe should be sent to the server.
+ * @return true if the server is dead, the dead time is over and no probe
+ * is outstanding.
+ */
+bool RadiusServer::needsProbe(void)
+{
+	return (this->deadcount>0 && this->statusserver && !this->probing && time(NULL)>=this->deaduntil);
+}
+
+/** The setter method for the outstanding probe.
+ * @param b true if a probe was sent, false if it is finished.
+ */
+void RadiusServer::setProbing(bool b)
+{
+	this->probing=b;
+}
+
+/** The method is called when the server answered a request, 
+ * the server is alive.
+ */
+void RadiusServer::markResponse(void)
+{
+	if (this->deadcount>0)
+	{
+		cerr << "RADIUS-CLASS: Server " << this->name << " is alive again.\n";
+	}
+	this->fails=0;
+	this->deadcount=0;
+}
+
+/** The method is called when the server didn't answer a request.
+ * After maxfails requests in a row the server is marked as dead for deadtime
+ * seconds. If the server fails again after the dead time, the time is doubled.
+ */
+void RadiusServer::markFailure(void)
+{
+	int t;
+	
+	this->fails++;
+	if (this->deadcount>0 || this->fails>=this->maxfails)
+	{
+		if (this->deadcount<6)
+		{
+			this->deadcount++;
+		}
+		t=this->deadtime<<(this->deadcount-1);
+		this->deaduntil=time(NULL)+t;
+		this->fails=0;
+		cerr << "RADIUS-CLASS: Server " << this->name << " is marked as dead for " << t << " seconds.\n";
+	}
+}
+
+/** The getter method for the weight of the server.
+ * @return The weight.
+ */
+int RadiusServer::getWeight(void)
+{
+	return this->weight;
+}
+
+/** The setter method for the weight of the server. A server with
+ * the weight 2 gets twice as many requests as a server with the weight 1.
+ * @param w The weight, if it is less than 1 it is set to 1.
+ */
+void RadiusServer::setWeight(int w)
+{
+	if (w<1)
+	{
+		w=1;
+	}
+	this->weight=w;
+}
+
+/** The getter method for the current value of the weighted round robin.
+ * @return The value.
+ */
+int RadiusServer::getCurrentWeight(void)
+{
+	return this->currentweight;
+}
+
+/** The setter method for the current value of the weighted round robin.
+ * @param w The value.
+ */
+void RadiusServer::setCurrentWeight(int w)
+{
+	this->currentweight=w;
+}
+
+/** The getter method for the number of requests which wait
+ * for a response of the server.
+ * @return The number of requests.
+ */
+int RadiusServer::getOutstanding(void)
+{
+	return this->outstanding;
+}
+
+/** The method is called when a request was sent to the server.
+ */
+void RadiusServer::incOutstanding(void)
+{
+	this->outstanding++;
+}
+
+/** The method is called when a request is not waiting any longer
+ * for a response of the server.
+ */
+void RadiusServer::decOutstanding(void)
+{
+	if (this->outstanding>0)
+	{
+		this->outstanding--;
+	}
+}
+
+/** The getter method for the minimum retransmission timeout.
+ * @return The timeout in milliseconds.
+ */
+int RadiusServer::getRtoMin(void)
+{
+	return this->rtomin;
+}
+
+/** The setter method for the minimum retransmission timeout.
+ * @param ms The timeout in milliseconds.
+ */
+void RadiusServer::setRtoMin(int ms)
+{
+	this->rtomin=ms;
+}
+
+/** The getter method for the maximum retransmission timeout.
+ * @return The timeout in milliseconds.
+ */
+int RadiusServer::getRtoMax(void)
+{
+	return this->rtomax;
+}
+
+/** The setter method for the maximum retransmission timeout.
+ * @param ms The timeout in milliseconds.
+ */
+void RadiusServer::setRtoMax(int ms)
+{
+	this->rtomax=ms;
+}
+
+/** The method calculates the retransmission timeout like TCP (RFC 6298) from
+ * the smoothed round trip time and its variation. The timeout is doubled for
+ * every retransmission and is between the minimum and the maximum timeout, 
+ * the wait time is the hard upper bound. As long as there is no sample 
+ * the maximum is used.
+ * @param retransmissions The number of retransmissions of the packet.
+ * @return The timeout in milliseconds.
+ */
+int RadiusServer::getRto(int retransmissions)
+{
+	int rto, max;
+	
+	max=this->wait*1000;
+	if (this->rtomax>0 && this->rtomax<max)
+	{
+		max=this->rtomax;
+	}
+	if (this->srtt==0)
+	{
+		return max;
+	}
+	rto=(this->srtt+4*this->rttvar+999)/1000;
+	if (rto<this->rtomin)
+	{
+		rto=this->rtomin;
+	}
+	while (retransmissions-- > 0 && rto<max)
+	{
+		rto*=2;
+	}
+	if (rto>max)
+	{
+		rto=max;
+	}
+	return rto;
+}
+
+/** The method updates the smoothed round trip time and its variation
+ * with a new sample. Samples of retransmitted packets must not be used (Karn's 
+ * algorithm), because it is unknown which transmission was answered.
+ * The sample is saved for getLatency(), too.
+ * @param us The round trip time in microseconds.
+ */
+void RadiusServer::updateRtt(int us)
+{
+	int delta;
+	
+	if (us<=0)
+	{
+		us=1;
+	}
+	this->latency[this->latencynext]=us;
+	this->latencynext=(this->latencynext+1)%RADIUS_LATENCY_SAMPLES;
+	if (this->latencycount<RADIUS_LATENCY_SAMPLES)
+	{
+		this->latencycount++;
+	}
+	if (this->srtt==0)
+	{
+		this->srtt=us;
+		this->rttvar=us/2;
+		return;
+	}
+	delta=this->srtt-us;
+	if (delta<0)
+	{
+		delta=-delta;
+	}
+	this->rttvar=(3*this->rttvar+delta)/4;
+	this->srtt=(7*this->srtt+us)/8;
+}
+
+/** The method calculates a percentile of the last round trip times.
+ * @param percentile The percentile, between 1 and 100.
+ * @return The round trip time in microseconds, 0 if there are 
+ * less than RADIUS_LATENCY_MIN_SAMPLES samples.
+ */
+int RadiusServer::getLatency(int percentile)
+{
+	int samples[RADIUS_LATENCY_SAMPLES];
+	int n;
+	
+	if (this->latencycount<RADIUS_LATENCY_MIN_SAMPLES)
+	{
+		return 0;
+	}
+	memcpy(samples, this->latency, this->latencycount*sizeof(int));
+	n=(this->latencycount*percentile+99)/100-1;
+	if (n<0)
+	{
+		n=0;
+	}
+	if (n>=this->latencycount)
+	{
+		n=this->latencycount-1;
+	}
+	nth_element(samples, samples+n, samples+this->latencycount);
+	return samples[n];
+}
+
 ostream& operator << (ostream& os, RadiusServer& server)
 {
      os << "\n\nRadiusServer:";
@@ -194,6 +1135,14 @@ ostream& operator << (ostream& os, RadiusServer& server)
      os << "\nAccounting-Port: " << server.acctport;
      os << "\nRetries: " << server.retry;
      os << "\nWait: " << server.wait;
+     os << "\nTransport: " << server.transport;
+     os << "\nResolve-TTL: " << server.resolvettl;
+     os << "\nMax-Fails: " << server.maxfails;
+     os << "\nDead-Time: " << server.deadtime;
+     os << "\nStatus-Server: " << server.statusserver;
+     os << "\nWeight: " << server.weight;
+     os << "\nRTO-Min: " << server.rtomin;
+     os << "\nRTO-Max: " << server.rtomax;
      os << "\nSharedSecret: *******";
  	return os;
  	
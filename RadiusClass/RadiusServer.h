@@ -23,8 +23,26 @@
 #define _RADIUSSERVER_H_
 #include <string>
 #include <iostream>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <signal.h>
+#include <pthread.h>
+#include <time.h>
+#include <vector>
+#include "RadiusCrypto.h"
 
 using namespace std;
+
+/** The number of round trip times which are saved for the latency percentiles.*/
+#define RADIUS_LATENCY_SAMPLES		64
+/** The number of round trip times which are needed for a latency percentile.*/
+#define RADIUS_LATENCY_MIN_SAMPLES	16
+
+/** The transports to a radius server.*/
+#define RADIUS_TRANSPORT_UDP		0	/**< UDP (RFC 2865).*/
+#define RADIUS_TRANSPORT_TCP		1	/**< TCP (RFC 6613).*/
+#define RADIUS_TRANSPORT_UNIX		2	/**< A Unix stream socket with the framing of RFC 6613, the name is the path.*/
+
 /** This class represents a radius server.*/
 
 class RadiusServer
@@ -35,15 +53,74 @@ private:
 	string name;				/**< The name or the ip address of the server.*/
 	int 	retry; 				/**< The number of retries how many times a radius ticket is send to the server, if it doesn#t answer.*/
 	string sharedsecret;		/**< The sharedsecret, the maximum space is 16 chars.*/
+	RadiusCrypto crypto;		/**< The hash contexts of the sharedsecret.*/
 	int 	wait;				/**< The time to wait for a response of the server.*/
+	int		transport;			/**< The transport, see RADIUS_TRANSPORT_*.*/
+	
+	int		authsock;			/**< The connected UDP socket for authentication packets, -1 if it is not open.*/
+	int		acctsock;			/**< The connected UDP socket for accounting packets, -1 if it is not open.*/
+	vector<int> stalesockets;	/**< The sockets which can't be used for the new address, the RadiusClient closes them.*/
+	bool	resolved;			/**< Is true if the address in addr is valid.*/
+	bool	numeric;			/**< Is true if the name is an ip address, it is never resolved again.*/
+	struct sockaddr_storage addr;/**< The resolved IPv4 or IPv6 address of the server, the port is not set.*/
+	socklen_t addrlen;			/**< The length of the address.*/
+	time_t	resolvetime;		/**< The time when the name was resolved.*/
+	int		resolvettl;			/**< The time in seconds how long the address is cached, 0 means forever.*/
+	int		generation;			/**< The value of resolvegeneration when the name was resolved.*/
+	pthread_mutex_t mutex;		/**< The mutex protects the address cache and the sockets.*/
+	pthread_t refresher;		/**< The thread which resolves the expired address.*/
+	bool	refresherstarted;	/**< Is true if the refresher was started and is not joined.*/
+	bool	refreshing;			/**< Is true while the refresher resolves the name.*/
+	
+	int		fails;				/**< The number of requests in a row the server didn't answer.*/
+	int		maxfails;			/**< After this number of failed requests the server is marked as dead.*/
+	int		deadtime;			/**< The time in seconds a server is marked as dead the first time.*/
+	int		deadcount;			/**< How many times in a row the server was marked as dead, 0 if it is alive.*/
+	time_t	deaduntil;			/**< The time until the server is skipped.*/
+	bool	statusserver;		/**< Is true if the server is probed with Status-Server packets.*/
+	bool	probing;			/**< Is true if a probe is outstanding.*/
+	
+	int		weight;				/**< The weight of the server for the balancing.*/
+	int		currentweight;		/**< The current value for the weighted round robin.*/
+	int		outstanding;		/**< The number of requests which wait for a response of the server.*/
+	
+	int		srtt;				/**< The smoothed round trip time in microseconds, 0 if there is no sample.*/
+	int		rttvar;				/**< The variation of the round trip time in microseconds.*/
+	int		rtomin;				/**< The minimum retransmission timeout in milliseconds.*/
+	int		rtomax;				/**< The maximum retransmission timeout in milliseconds.*/
+	int		latency[RADIUS_LATENCY_SAMPLES]; /**< The last round trip times in microseconds.*/
+	int		latencycount;		/**< The number of samples in latency.*/
+	int		latencynext;		/**< The index of the next sample in latency.*/
+	
+	static volatile sig_atomic_t resolvegeneration; /**< It is incremented by expireAddresses().*/
+	
+	bool	addressExpired(void);
+	static int lookupAddress(const string &, struct sockaddr_storage *, socklen_t *);
+	int		resolveAddress(void);
+	void	setAddress(const struct sockaddr_storage *, socklen_t);
+	void	staleSockets(void);
+	void	startRefresh(void);
+	void	joinRefresh(void);
+	static void * refreshAddress(void *);
+	int		connectSocket(int sock, short int port);
+	int		openSocket(short int port);
+	int		openStream(short int port);
+	int		getSocket(int *sock, short int port);
 
 public:
 	
 	
 	RadiusServer(string name="127.0.0.1",string secret = "", int authport=1812, int acctport=1813, int retry=3, int wait=1);
+	RadiusServer(const RadiusServer &);
 	~RadiusServer();
 	RadiusServer &operator=(const RadiusServer &);
 	
+	int getAuthSocket(void);
+	int getAcctSocket(void);
+	void closeSockets(void);
+	void releaseSocket(int);
+	int takeStaleSocket(void);
+	
 	int getRetry();
 	void setRetry(int);
 	
@@ -52,6 +129,7 @@ public:
 	
 	void setSharedSecret(string);
 	string getSharedSecret(void);
+	RadiusCrypto * getCrypto(void);
 	
 	int getAuthPort();
 	void setAuthPort(short int);
@@ -62,6 +140,50 @@ public:
 	string getName();
 	void setName(string);
 	
+	int getTransport(void);
+	void setTransport(int);
+	int setTransport(string);
+	
+	int getResolveTtl(void);
+	void setResolveTtl(int);
+	
+	static void expireAddresses(void);
+	
+	int getMaxFails(void);
+	void setMaxFails(int);
+	
+	int getDeadTime(void);
+	void setDeadTime(int);
+	
+	bool getStatusServer(void);
+	void setStatusServer(bool);
+	
+	bool isAlive(void);
+	bool needsProbe(void);
+	void setProbing(bool);
+	void markResponse(void);
+	void markFailure(void);
+	
+	int getWeight(void);
+	void setWeight(int);
+	
+	int getCurrentWeight(void);
+	void setCurrentWeight(int);
+	
+	int getOutstanding(void);
+	void incOutstanding(void);
+	void decOutstanding(void);
+	
+	int getRtoMin(void);
+	void setRtoMin(int);
+	
+	int getRtoMax(void);
+	void setRtoMax(int);
+	
+	int getRto(int);
+	void updateRtt(int);
+	int getLatency(int);
+	
 	friend ostream& operator << (ostream& os, RadiusServer& server);
 };
 
@@ -0,0 +1,418 @@
+/*
+ *  RadiusClass -- An C++-Library for radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+#include "RadiusServerGroup.h"
+#include <stdio.h>
+
+/** The constructor of the class. The group has no servers 
+ * and the policy is failover.
+ */
+RadiusServerGroup::RadiusServerGroup(void)
+{
+	this->policy=BALANCE_FAILOVER;
+	this->counter=0;
+	this->hedgepercentile=0;
+	this->hedgebudget=10;
+	this->maxinflight=0;
+	this->hedgesecond=0;
+	this->hedgecount=0;
+	this->inflight=0;
+}
+
+/** The copy constructor of the class. The servers are copied, 
+ * the hash ring is built again on the first use.
+ * @param g A reference to a RadiusServerGroup.
+ */
+RadiusServerGroup::RadiusServerGroup(const RadiusServerGroup &g)
+{
+	this->servers=g.servers;
+	this->policy=g.policy;
+	this->counter=0;
+	this->hedgepercentile=g.hedgepercentile;
+	this->hedgebudget=g.hedgebudget;
+	this->maxinflight=g.maxinflight;
+	this->hedgesecond=0;
+	this->hedgecount=0;
+	this->inflight=0;
+}
+
+/** The destructor of the class. It clears the server list.
+ */
+RadiusServerGroup::~RadiusServerGroup(void)
+{
+	this->ring.clear();
+	this->servers.clear();
+}
+
+/** The assignment operator.
+ * @param g A reference to a RadiusServerGroup.
+ */
+RadiusServerGroup &RadiusServerGroup::operator=(const RadiusServerGroup &g)
+{
+	if (this!=&g)
+	{
+		this->ring.clear();
+		this->servers=g.servers;
+		this->policy=g.policy;
+		this->counter=0;
+		this->hedgepercentile=g.hedgepercentile;
+		this->hedgebudget=g.hedgebudget;
+		this->maxinflight=g.maxinflight;
+		this->hedgesecond=0;
+		this->hedgecount=0;
+		this->inflight=0;
+	}
+	return (*this);
+}
+
+/** The getter method for the server list.
+ * @return A pointer to the server list.
+ */
+list<RadiusServer> * RadiusServerGroup::getServers(void)
+{
+	return (&this->servers);
+}
+
+/** The method adds a copy of a server at the end of the list.
+ * @param server The server.
+ */
+void RadiusServerGroup::addServer(const RadiusServer &server)
+{
+	this->servers.push_back(server);
+	this->ring.clear();
+}
+
+/** The getter method for the balancing policy.
+ * @return The policy, see BALANCE_*.
+ */
+int RadiusServerGroup::getPolicy(void)
+{
+	return this->policy;
+}
+
+/** The setter method for the balancing policy.
+ * @param p The policy, see BALANCE_*.
+ */
+void RadiusServerGroup::setPolicy(int p)
+{
+	this->policy=p;
+}
+
+/** The setter method for the balancing policy with the
+ * name from the config file.
+ * @param name One of failover, roundrobin, weighted, leastoutstanding or hash.
+ * @return 0 if the name is known, else PARSING_ERROR.
+ */
+int RadiusServerGroup::setPolicy(string name)
+{
+	if (name=="failover") this->policy=BALANCE_FAILOVER;
+	else if (name=="roundrobin") this->policy=BALANCE_ROUNDROBIN;
+	else if (name=="weighted") this->policy=BALANCE_WEIGHTED;
+	else if (name=="leastoutstanding") this->policy=BALANCE_LEASTOUTSTANDING;
+	else if (name=="hash") this->policy=BALANCE_HASH;
+	else return PARSING_ERROR;
+	return 0;
+}
+
+/** The method calculates the FNV-1a hash of a string. The result is mixed
+ * again, because names which differ only in the last character would be 
+ * close together on the ring.
+ * @param str The string.
+ * @return The hash.
+ */
+unsigned int RadiusServerGroup::hash(const string &str)
+{
+	unsigned int h=2166136261U;
+	string::size_type i;
+	
+	for (i=0; i<str.size(); i++)
+	{
+		h^=(unsigned char)str[i];
+		h*=16777619U;
+	}
+	h^=h>>16;
+	h*=0x85ebca6bU;
+	h^=h>>13;
+	h*=0xc2b2ae35U;
+	h^=h>>16;
+	return h;
+}
+
+/** The method builds the hash ring for the consistent hashing. Every
+ * server gets weight*BALANCE_HASH_POINTS points on the ring, so only the 
+ * users of a removed server move to other servers.
+ */
+void RadiusServerGroup::buildRing(void)
+{
+	list<RadiusServer>::iterator server;
+	char point[32];
+	int i;
+	
+	this->ring.clear();
+	for (server=this->servers.begin(); server!=this->servers.end(); server++)
+	{
+		for (i=0; i<server->getWeight()*BALANCE_HASH_POINTS; i++)
+		{
+			snprintf(point, sizeof(point), ":%d#%d", server->getAuthPort(), i);
+			this->ring.insert(make_pair(hash(server->getName()+point), server));
+		}
+	}
+}
+
+/** The method selects the server where a request starts. Dead servers
+ * are not selected, if all servers are dead the first server is returned.
+ * @param key The key for the consistent hashing, it is the user name.
+ * @return An iterator to the server, it is the end of the list if the group
+ * has no servers.
+ */
+list<RadiusServer>::iterator RadiusServerGroup::selectServer(const string &key)
+{
+	list<RadiusServer>::iterator server, best;
+	map<unsigned int, list<RadiusServer>::iterator>::iterator point;
+	unsigned int i, n=this->servers.size();
+	int total=0;
+	
+	best=this->servers.end();
+	if (n==0)
+	{
+		return best;
+	}
+	
+	switch (this->policy)
+	{
+		case BALANCE_ROUNDROBIN:
+		case BALANCE_LEASTOUTSTANDING:
+			//start at the next server, so the servers are used in
+			//turn if they have the same load
+			server=this->servers.begin();
+			for (i=this->counter++ % n; i>0; i--)
+			{
+				server++;
+			}
+			for (i=0; i<n; i++, server++)
+			{
+				if (server==this->servers.end())
+				{
+					server=this->servers.begin();
+				}
+				if (!server->isAlive())
+				{
+					continue;
+				}
+				if (this->policy==BALANCE_ROUNDROBIN)
+				{
+					return server;
+				}
+				//compare outstanding/weight without a division
+				if (best==this->servers.end() || 
+					server->getOutstanding()*best->getWeight() < best->getOutstanding()*server->getWeight())
+				{
+					best=server;
+				}
+			}
+			break;
+			
+		case BALANCE_WEIGHTED:
+			//smooth weighted round robin: every server gets its weight,
+			//the server with the highest value is taken and loses the sum of the weights
+			for (server=this->servers.begin(); server!=this->servers.end(); server++)
+			{
+				if (!server->isAlive())
+				{
+					continue;
+				}
+				server->setCurrentWeight(server->getCurrentWeight()+server->getWeight());
+				total+=server->getWeight();
+				if (best==this->servers.end() || server->getCurrentWeight()>best->getCurrentWeight())
+				{
+					best=server;
+				}
+			}
+			if (best!=this->servers.end())
+			{
+				best->setCurrentWeight(best->getCurrentWeight()-total);
+			}
+			break;
+			
+		case BALANCE_HASH:
+			if (this->ring.empty())
+			{
+				this->buildRing();
+			}
+			//the first alive server clockwise on the ring
+			point=this->ring.lower_bound(hash(key));
+			for (i=0; i<this->ring.size(); i++, point++)
+			{
+				if (point==this->ring.end())
+				{
+					point=this->ring.begin();
+				}
+				if (point->second->isAlive())
+				{
+					return point->second;
+				}
+			}
+			break;
+			
+		default:
+			break;
+	}
+	
+	if (best==this->servers.end())
+	{
+		best=this->servers.begin();
+	}
+	return best;
+}
+
+/** The getter method for the latency percentile of the hedging.
+ * @return The percentile, 0 if hedging is off.
+ */
+int RadiusServerGroup::getHedgePercentile(void)
+{
+	return this->hedgepercentile;
+}
+
+/** The setter method for the latency percentile of the hedging. If an
+ * Access-Request is not answered in this percentile of the round trip times
+ * of the server, it is sent to the next server, too.
+ * @param p The percentile between 1 and 99, 0 switches hedging off.
+ */
+void RadiusServerGroup::setHedgePercentile(int p)
+{
+	if (p<0 || p>99)
+	{
+		p=0;
+	}
+	this->hedgepercentile=p;
+}
+
+/** The getter method for the hedging budget.
+ * @return The maximum number of hedged requests per second.
+ */
+int RadiusServerGroup::getHedgeBudget(void)
+{
+	return this->hedgebudget;
+}
+
+/** The setter method for the hedging budget.
+ * @param b The maximum number of hedged requests per second.
+ */
+void RadiusServerGroup::setHedgeBudget(int b)
+{
+	this->hedgebudget=b;
+}
+
+/** The method takes a hedged request from the budget of the
+ * current second.
+ * @return True if the request may be hedged, false if the budget is used up.
+ */
+bool RadiusServerGroup::takeHedge(void)
+{
+	time_t now=time(NULL);
+	
+	if (now!=this->hedgesecond)
+	{
+		this->hedgesecond=now;
+		this->hedgecount=0;
+	}
+	if (this->hedgecount>=this->hedgebudget)
+	{
+		return false;
+	}
+	this->hedgecount++;
+	return true;
+}
+
+/** The getter method for the in-flight limit of the group.
+ * @return The maximum number of requests, 0 means no limit.
+ */
+int RadiusServerGroup::getMaxInFlight(void)
+{
+	return this->maxinflight;
+}
+
+/** The setter method for the in-flight limit of the group. More
+ * requests wait in the RadiusClient until a request of the group is finished, 
+ * so a slow group doesn't hold up the other groups.
+ * @param m The maximum number of requests, 0 means no limit.
+ */
+void RadiusServerGroup::setMaxInFlight(int m)
+{
+	if (m<0)
+	{
+		m=0;
+	}
+	this->maxinflight=m;
+}
+
+/** The method counts a request which is sent to the group.
+ * @return False if the in-flight limit is reached, then the request
+ * is not counted.
+ */
+bool RadiusServerGroup::takeInFlight(void)
+{
+	if (this->maxinflight>0 && this->inflight>=this->maxinflight)
+	{
+		return false;
+	}
+	this->inflight++;
+	return true;
+}
+
+/** The method is called when a request of the group is finished.
+ */
+void RadiusServerGroup::releaseInFlight(void)
+{
+	if (this->inflight>0)
+	{
+		this->inflight--;
+	}
+}
+
+/** The method divides the hedging budget and the in-flight limit between the
+ * processes which send the requests of the group, e.g. the authentication workers. 
+ * Every process gets at least 1, if the value is not 0.
+ * @param n The number of processes.
+ */
+void RadiusServerGroup::shareLimits(int n)
+{
+	if (n>1)
+	{
+		this->hedgebudget=(this->hedgebudget+n-1)/n;
+		this->maxinflight=(this->maxinflight+n-1)/n;
+	}
+}
+
+ostream& operator << (ostream& os, RadiusServerGroup& group)
+{
+	list<RadiusServer>::iterator server;
+	
+	os << "\nBalance: " << group.policy;
+	os << "\nHedge-Percentile: " << group.hedgepercentile;
+	os << "\nHedge-Budget: " << group.hedgebudget;
+	os << "\nMax-In-Flight: " << group.maxinflight;
+	for (server=group.servers.begin(); server!=group.servers.end(); server++)
+	{
+		os << *server;
+	}
+	return os;
+}
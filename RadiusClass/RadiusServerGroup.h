@@ -0,0 +1,100 @@
+/*
+ *  RadiusClass -- An C++-Library for radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+#ifndef _RADIUSSERVERGROUP_H_
+#define _RADIUSSERVERGROUP_H_
+
+#include <string>
+#include <list>
+#include <map>
+#include <iostream>
+#include <time.h>
+
+#include "RadiusServer.h"
+#include "error.h"
+
+using namespace std;
+
+/** The policies how the requests are distributed over the servers of a group.*/
+#define BALANCE_FAILOVER			0	/**< Every request starts at the first server.*/
+#define BALANCE_ROUNDROBIN			1	/**< The requests start at the servers in turn.*/
+#define BALANCE_WEIGHTED			2	/**< Like round robin, the servers get requests in the ratio of their weights.*/
+#define BALANCE_LEASTOUTSTANDING	3	/**< The server with the fewest outstanding requests per weight is taken.*/
+#define BALANCE_HASH				4	/**< The server is found by a consistent hash of the user name.*/
+
+/** The number of points of a server with the weight 1 on the hash ring.*/
+#define BALANCE_HASH_POINTS			40
+
+/** This class represents a group of radius servers and the policy how
+ * the requests are distributed over the servers. A request starts at the server
+ * which is selected by the policy, if it doesn't answer the next servers of the
+ * list are tried.*/
+class RadiusServerGroup
+{
+private:
+	list<RadiusServer>	servers;		/**< The servers of the group.*/
+	int					policy;			/**< The balancing policy, see BALANCE_*.*/
+	unsigned int		counter;		/**< The counter for round robin.*/
+	map<unsigned int, list<RadiusServer>::iterator> ring; /**< The hash ring, it is built on the first use.*/
+	int					hedgepercentile;/**< The latency percentile after which a request is hedged, 0 if hedging is off.*/
+	int					hedgebudget;	/**< The maximum number of hedged requests per second.*/
+	time_t				hedgesecond;	/**< The second of the hedged requests in hedgecount.*/
+	int					hedgecount;		/**< The number of hedged requests in hedgesecond.*/
+	int					maxinflight;	/**< The maximum number of requests of the group which are sent at the same time, 0 means no limit.*/
+	int					inflight;		/**< The number of requests of the group which are sent.*/
+	
+	void				buildRing(void);
+	static unsigned int	hash(const string &);
+	
+public:
+	RadiusServerGroup(void);
+	RadiusServerGroup(const RadiusServerGroup &);
+	~RadiusServerGroup(void);
+	RadiusServerGroup &operator=(const RadiusServerGroup &);
+	
+	list<RadiusServer> * getServers(void);
+	void addServer(const RadiusServer &);
+	
+	int getPolicy(void);
+	void setPolicy(int);
+	int setPolicy(string);
+	
+	list<RadiusServer>::iterator selectServer(const string &key);
+	
+	int getHedgePercentile(void);
+	void setHedgePercentile(int);
+	
+	int getHedgeBudget(void);
+	void setHedgeBudget(int);
+	
+	bool takeHedge(void);
+	
+	int getMaxInFlight(void);
+	void setMaxInFlight(int);
+	
+	bool takeInFlight(void);
+	void releaseInFlight(void);
+	void shareLimits(int);
+	
+	friend ostream& operator << (ostream& os, RadiusServerGroup& group);
+};
+
+#endif //_RADIUSSERVERGROUP_H_
@@ -22,6 +22,7 @@
 #include "RadiusVendorSpecificAttribute.h"
 #include <stdlib.h>
 #include "error.h"
+#include "RadiusAttribute.h"
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
@@ -171,11 +172,15 @@ int RadiusVendorSpecificAttribute::decodeRecvAttribute(Octet * v)
  * if the datatype is an integer. This dependents on the definition
  * in the radius RFC or can be locked up in the file radius.h of this 
  * source code.
- * @return The transformed integer.
+ * @return The transformed integer, 0 if the value is shorter than 4 octets.
  */
 int RadiusVendorSpecificAttribute::intFromBuf(void)
 {
-	return (ntohl(*(int*)this->value));
+	if (this->length<6)
+	{
+		return 0;
+	}
+	return RadiusAttribute::intFromBuf(this->value);
 }
 
 /**The overloading of the assignment operator.*/
@@ -238,41 +243,15 @@ int RadiusVendorSpecificAttribute::setValue(int value)
  */
 string RadiusVendorSpecificAttribute::ipFromBuf(void)
 {
-	int num,i;
-	char ip2[4],ip3[16];
-	memset(ip3,0,16);
-	for (i=0;i<(this->length-2);i++)
-	{
-		num=(int)this->value[i];
-		if(i==0)
-		{
-			sprintf(ip3,"%i",num);
-			strcat(ip3,".");
-		}
-		else if (i<3)
-		{
-			sprintf(ip2,"%i",num);
-			strcat(ip3,ip2);
-			strcat(ip3,".");
-		}
-		else
-		{
-			sprintf(ip2,"%i",num);
-			strcat(ip3,ip2);
-		}
-	}
-	return string(ip3);			 
-}  
+	return RadiusAttribute::ipFromBuf(this->value, this->length-2);
+}
 
 /** The method converts the value into a strung.
  * @return The value as a string.
  */
 string RadiusVendorSpecificAttribute::stringFromBuf(void)
 {
-	char * tmp_str = new char[this->length-1];
-	memcpy(tmp_str, this->value, this->length-2);
-	tmp_str[this->length-2]=0;
-	return string(tmp_str);	 
+	return string((const char *)this->value, strnlen((const char *)this->value, this->length-2));
 }
 
 /** The method copies id, type, length an value in 
@@ -0,0 +1,299 @@
+/*
+ *  RadiusClass -- An C++-Library for radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+
+#include "RadiusSamples.h"
+#include <stdio.h>
+
+/** The vendor specific attributes of the responses, one of every data type.*/
+static const struct
+{
+	uint32_t	vendor;
+	Octet		type;
+	Octet		len;
+	const char	*value;
+} vsasamples[]=
+{
+	{9, 1, 28, "ip:inacl#1=permit ip any any"},	//Cisco-AVPair, string
+	{9, 187, 4, "\x00\x00\x00\x07"},				//Cisco-Multilink-ID, integer
+	{311, 28, 4, "\x0a\x08\x00\x01"},				//MS-Primary-DNS-Server, ipaddr
+	{2636, 1, 8, "operator"},						//Juniper-Local-User-Name, string
+};
+
+/** Appends an attribute to a buffer of a packet, it is skipped if the
+ * buffer is full.
+ * @param buf The buffer with RADIUS_MAX_PACKET_LEN octets.
+ * @param pos The length of the packet, it is incremented.
+ * @param type The type of the attribute.
+ * @param value The value.
+ * @param len The length of the value.
+ */
+static void put(Octet *buf, int *pos, Octet type, const void *value, int len)
+{
+	if (len>253 || *pos+len+2>RADIUS_MAX_PACKET_LEN)
+	{
+		return;
+	}
+	buf[(*pos)++]=type;
+	buf[(*pos)++]=len+2;
+	memcpy(buf+*pos, value, len);
+	*pos+=len;
+}
+
+/** The method builds an Access-Request like UserAuth::sendAcceptRequestPacket()
+ * with the packet builder, the NAS attributes of the config are included.
+ * @param packet The empty packet with the code ACCESS_REQUEST.
+ */
+void RadiusSamples::accessRequest(RadiusPacket *packet)
+{
+	packet->appendAttribute(ATTRIB_User_Name, "testuser@example.org");
+	packet->appendPassword("secretpassword");
+	packet->appendInteger(ATTRIB_NAS_Port, 12);
+	packet->appendAttribute(ATTRIB_Calling_Station_Id, "192.168.100.27");
+	packet->appendAttribute(ATTRIB_NAS_Identifier, "OpenVpn");
+	packet->appendIpAddress(ATTRIB_NAS_IP_Address, "127.0.0.1");
+	packet->appendInteger(ATTRIB_NAS_Port_Type, 5);
+	packet->appendInteger(ATTRIB_Service_Type, 5);
+	packet->appendInteger(ATTRIB_Framed_Protocol, 1);
+	packet->appendAttribute(ATTRIB_Acct_Session_ID, "6f2b8c41d0e9a7353c1e4f8b92d07a6e");
+}
+
+/** The method builds the same Access-Request as accessRequest() with 
+ * RadiusAttribute objects in the multimap of the packet.
+ * @param packet The empty packet with the code ACCESS_REQUEST.
+ */
+void RadiusSamples::accessRequestAttributes(RadiusPacket *packet)
+{
+	RadiusAttribute	ra1(ATTRIB_User_Name, "testuser@example.org"),
+					ra2(ATTRIB_User_Password, "secretpassword"),
+					ra3(ATTRIB_NAS_Port, (uint32_t) 12),
+					ra4(ATTRIB_Calling_Station_Id, "192.168.100.27"),
+					ra5(ATTRIB_NAS_Identifier, "OpenVpn"),
+					ra6(ATTRIB_NAS_IP_Address, "127.0.0.1"),
+					ra7(ATTRIB_NAS_Port_Type, (uint32_t) 5),
+					ra8(ATTRIB_Service_Type, (uint32_t) 5),
+					ra9(ATTRIB_Framed_Protocol, (uint32_t) 1),
+					ra10(ATTRIB_Acct_Session_ID, "6f2b8c41d0e9a7353c1e4f8b92d07a6e");
+	
+	packet->addRadiusAttribute(&ra1);
+	packet->addRadiusAttribute(&ra2);
+	packet->addRadiusAttribute(&ra3);
+	packet->addRadiusAttribute(&ra4);
+	packet->addRadiusAttribute(&ra5);
+	packet->addRadiusAttribute(&ra6);
+	packet->addRadiusAttribute(&ra7);
+	packet->addRadiusAttribute(&ra8);
+	packet->addRadiusAttribute(&ra9);
+	packet->addRadiusAttribute(&ra10);
+}
+
+/** The method builds an Interim-Update like UserAcct::buildPacket().
+ * @param packet The empty packet with the code ACCOUNTING_REQUEST.
+ */
+void RadiusSamples::accountingRequest(RadiusPacket *packet)
+{
+	packet->appendAttribute(ATTRIB_User_Name, "testuser@example.org");
+	packet->appendIpAddress(ATTRIB_Framed_IP_Address, "10.8.0.6");
+	packet->appendInteger(ATTRIB_NAS_Port, 12);
+	packet->appendAttribute(ATTRIB_Calling_Station_Id, "192.168.100.27");
+	packet->appendAttribute(ATTRIB_Acct_Session_ID, "6f2b8c41d0e9a7353c1e4f8b92d07a6e");
+	packet->appendAttribute(ATTRIB_NAS_Identifier, "OpenVpn");
+	packet->appendIpAddress(ATTRIB_NAS_IP_Address, "127.0.0.1");
+	packet->appendInteger(ATTRIB_NAS_Port_Type, 5);
+	packet->appendInteger(ATTRIB_Service_Type, 5);
+	packet->appendInteger(ATTRIB_Framed_Protocol, 1);
+	packet->appendInteger(ATTRIB_Acct_Status_Type, 3);
+	packet->appendInteger(ATTRIB_Acct_Input_Octets, 183562);
+	packet->appendInteger(ATTRIB_Acct_Output_Octets, 2390187);
+	packet->appendInteger(ATTRIB_Acct_Session_Time, 3600);
+	packet->appendInteger(ATTRIB_Acct_Input_Gigawords, 0);
+	packet->appendInteger(ATTRIB_Acct_Output_Gigawords, 1);
+}
+
+/** The method builds the response of a server on a shaped request. An Access-Accept
+ * gets a Framed-IP-Address, an Acct-Interim-Interval, a Class and the routes and
+ * vendor specific attributes. The other codes get only the routes and the vendor 
+ * specific attributes.
+ * @param buf The buffer for the response, it must have RADIUS_MAX_PACKET_LEN octets.
+ * @param code The code of the response.
+ * @param request The request, it must be shaped for the server and must 
+ * not have parsed a response yet.
+ * @param server The server with the shared secret.
+ * @param routes The number of Framed-Route attributes.
+ * @param vsas The number of vendor specific attributes.
+ * @return The length of the response.
+ */
+int RadiusSamples::response(Octet *buf, Octet code, RadiusPacket *request, RadiusServer *server, int routes, int vsas)
+{
+	Octet		value[256];
+	char		route[64];
+	uint32_t	num;
+	int			pos=20, i, n;
+	
+	memset(buf, 0, 20);
+	buf[0]=code;
+	buf[1]=(Octet)request->getIdentifier();
+	if (code==ACCESS_ACCEPT)
+	{
+		put(buf, &pos, ATTRIB_Framed_IP_Address, "\x0a\x08\x00\x06", 4);
+		num=htonl(60);
+		put(buf, &pos, ATTRIB_Acct_Interim_Interval, &num, 4);
+		put(buf, &pos, ATTRIB_Class, "class-6f2b8c41", 14);
+	}
+	for (i=0; i<routes; i++)
+	{
+		n=snprintf(route, sizeof(route), "192.168.%d.0/24 10.8.0.1 1", i%256);
+		put(buf, &pos, ATTRIB_Framed_Route, route, n);
+	}
+	for (i=0; i<vsas; i++)
+	{
+		n=i%(sizeof(vsasamples)/sizeof(vsasamples[0]));
+		num=htonl(vsasamples[n].vendor);
+		memcpy(value, &num, 4);
+		value[4]=vsasamples[n].type;
+		value[5]=vsasamples[n].len+2;
+		memcpy(value+6, vsasamples[n].value, vsasamples[n].len);
+		put(buf, &pos, ATTRIB_Vendor_Specific, value, vsasamples[n].len+6);
+	}
+	buf[2]=(Octet)(pos>>8);
+	buf[3]=(Octet)pos;
+	sign(buf, pos, (const Octet *)request->getAuthenticator(), server);
+	return pos;
+}
+
+/** The method calculates the response authenticator of a response
+ * like a server: MD5(code+identifier+length+request authenticator+attributes+secret).
+ * @param buf The response.
+ * @param len The length of the hashed part of the response.
+ * @param authenticator The authenticator of the shaped request.
+ * @param server The server with the shared secret.
+ */
+void RadiusSamples::sign(Octet *buf, int len, const Octet *authenticator, RadiusServer *server)
+{
+	gcry_md_hd_t	context;
+	
+	context=server->getCrypto()->startDigest();
+	gcry_md_write(context, buf, 4);
+	gcry_md_write(context, authenticator, RADIUS_PACKET_AUTHENTICATOR_LEN);
+	gcry_md_write(context, buf+20, len-20);
+	server->getCrypto()->finishDigest(context, buf+4);
+}
+
+/** The method decodes a parsed response like UserAuth::parseResponsePacket(),
+ * the vendor specific attributes are decoded with decodeVendorSpecific().
+ * @param packet The packet with the response.
+ * @return The number of decoded attributes.
+ */
+int RadiusSamples::decodeResponse(RadiusPacket *packet)
+{
+	RadiusAttributeView	view;
+	string				routes, routes6, ip, ip6, msg;
+	int					count=0;
+	
+	while (packet->nextAttribute(&view))
+	{
+		switch (view.type)
+		{
+			case ATTRIB_Framed_Route:
+				routes.append((const char *) view.value, view.length);
+				routes.append(";");
+				break;
+			case ATTRIB_Framed_IP_Address:
+				ip=view.ipFromBuf();
+				break;
+			case ATTRIB_Framed_IPv6_Route:
+				routes6.append((const char *) view.value, view.length);
+				routes6.append(";");
+				break;
+			case ATTRIB_Framed_IPv6_Address:
+				ip6=view.ip6FromBuf();
+				break;
+			case ATTRIB_Acct_Interim_Interval:
+				if (view.length==4)
+				{
+					view.intFromBuf();
+				}
+				break;
+			case ATTRIB_Vendor_Specific:
+				decodeVendorSpecific(view.value, view.length);
+				break;
+			case ATTRIB_Reply_Message:
+				msg.append((const char *) view.value, view.length);
+				break;
+		}
+		count++;
+	}
+	return count;
+}
+
+/** The method decodes the sub attributes of a vendor specific attribute
+ * with RadiusVendorSpecificAttribute and converts the values with the data 
+ * type of the dictionary like UserAuth::valueToString().
+ * @param value The value of the attribute: the vendor id and the sub attributes.
+ * @param len The length of the value.
+ * @return The number of sub attributes or BAD_LENGTH if a sub attribute doesn't 
+ * fit into the attribute.
+ */
+int RadiusSamples::decodeVendorSpecific(const Octet *value, int len)
+{
+	const RadiusDictionaryEntry	*entry;
+	Octet						buf[260];
+	string						s;
+	int							pos=4, count=0;
+	
+	if (len<4)
+	{
+		return BAD_LENGTH;
+	}
+	memcpy(buf, value, 4);
+	while (pos<len)
+	{
+		if (pos+2>len || value[pos+1]<2 || pos+value[pos+1]>len)
+		{
+			return BAD_LENGTH;
+		}
+		
+		//the decoder expects the vendor id in front of every sub attribute
+		RadiusVendorSpecificAttribute vsa;
+		memcpy(buf+4, value+pos, value[pos+1]);
+		if (vsa.decodeRecvAttribute(buf)!=0)
+		{
+			return ALLOC_ERROR;
+		}
+		entry=RadiusDictionary::find(vsa.getId(), vsa.getType());
+		switch (entry!=NULL ? entry->datatype : RADIUS_VSA_OTHER)
+		{
+			case RADIUS_VSA_INTEGER:
+			case RADIUS_VSA_DATE:
+				vsa.intFromBuf();
+				break;
+			case RADIUS_VSA_IPADDR:
+				s=vsa.ipFromBuf();
+				break;
+			default:
+				s=vsa.stringFromBuf();
+				break;
+		}
+		pos+=value[pos+1];
+		count++;
+	}
+	return count;
+}
@@ -0,0 +1,48 @@
+/*
+ *  RadiusClass -- An C++-Library for radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+
+#ifndef _RADIUSSAMPLES_H_
+#define _RADIUSSAMPLES_H_
+
+#include "../RadiusPacket.h"
+#include "../RadiusServer.h"
+#include "../RadiusVendorSpecificAttribute.h"
+#include "../RadiusDictionary.h"
+
+/** The class builds the typical packets of the plugin for the benchmark and
+ * the fuzzer and decodes responses like the plugin does it. The responses 
+ * are signed with the shared secret, so they pass radiusParseResponse().*/
+class RadiusSamples
+{
+public:
+	static void		accessRequest(RadiusPacket *packet);
+	static void		accessRequestAttributes(RadiusPacket *packet);
+	static void		accountingRequest(RadiusPacket *packet);
+	
+	static int		response(Octet *buf, Octet code, RadiusPacket *request, RadiusServer *server, int routes, int vsas);
+	static void		sign(Octet *buf, int len, const Octet *authenticator, RadiusServer *server);
+	
+	static int		decodeResponse(RadiusPacket *packet);
+	static int		decodeVendorSpecific(const Octet *value, int len);
+};
+
+#endif //_RADIUSSAMPLES_H_
@@ -0,0 +1,256 @@
+/*
+ *  RadiusClass -- An C++-Library for radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+
+/* The benchmark measures the time and the allocations with operator new
+ * per operation of the encoding and decoding of typical packets.
+ * 
+ * usage: benchmark [-n iterations] [-r routes] [-v vsas]
+ *	-n	The number of operations of every test, default 100000.
+ *	-r	The number of Framed-Route attributes in the Access-Accept, default 16.
+ *	-v	The number of vendor specific attributes in the Access-Accept, default 8.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <new>
+#include "RadiusSamples.h"
+
+/** The number of calls of operator new.*/
+static unsigned long allocations=0;
+
+void * operator new(size_t size)
+{
+	void *p;
+	
+	allocations++;
+	if (!(p=malloc(size ? size : 1)))
+	{
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void * operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void *p) throw()
+{
+	free(p);
+}
+
+void operator delete[](void *p) throw()
+{
+	free(p);
+}
+
+/** The data of the tests.*/
+class BenchmarkContext
+{
+public:
+	RadiusServer	*server;	/**<The server with the shared secret.*/
+	RadiusPacket	*request;	/**<A shaped Access-Request for the responses.*/
+	RadiusPacket	*acctrequest;	/**<A shaped Accounting-Request for the responses.*/
+	Octet			accept[RADIUS_MAX_PACKET_LEN];	/**<The Access-Accept on request.*/
+	int				acceptlen;	/**<The length of the Access-Accept.*/
+	Octet			acctresponse[RADIUS_MAX_PACKET_LEN];	/**<The Accounting-Response on acctrequest.*/
+	int				acctresponselen;	/**<The length of the Accounting-Response.*/
+	Octet			vsa[64];	/**<The value of a vendor specific attribute.*/
+	int				vsalen;		/**<The length of the vendor specific attribute.*/
+};
+
+typedef void (*BenchmarkFunction)(BenchmarkContext *);
+
+static void encodeAccessRequest(BenchmarkContext *ctx)
+{
+	RadiusPacket packet(ACCESS_REQUEST);
+	
+	RadiusSamples::accessRequest(&packet);
+	packet.radiusShape(ctx->server, 0);
+}
+
+static void encodeAccessRequestAttributes(BenchmarkContext *ctx)
+{
+	RadiusPacket packet(ACCESS_REQUEST);
+	
+	RadiusSamples::accessRequestAttributes(&packet);
+	packet.radiusShape(ctx->server, 0);
+}
+
+static void encodeAccountingRequest(BenchmarkContext *ctx)
+{
+	RadiusPacket packet(ACCOUNTING_REQUEST);
+	
+	RadiusSamples::accountingRequest(&packet);
+	packet.radiusShape(ctx->server, 0);
+}
+
+static void hidePasswordSecret(BenchmarkContext *ctx)
+{
+	static RadiusAttribute	password(ATTRIB_User_Password, "secretpassword");
+	char					hidden[RADIUS_MAX_PASSWORD_LEN];
+	
+	password.makePasswordHash((char *) password.getValue(), hidden, "testing123", ctx->request->getAuthenticator());
+}
+
+static void hidePasswordCrypto(BenchmarkContext *ctx)
+{
+	static RadiusAttribute	password(ATTRIB_User_Password, "secretpassword");
+	char					hidden[RADIUS_MAX_PASSWORD_LEN];
+	
+	password.makePasswordHash((char *) password.getValue(), hidden, ctx->server->getCrypto(), ctx->request->getAuthenticator());
+}
+
+static void decodeAccessAccept(BenchmarkContext *ctx)
+{
+	if (ctx->request->radiusParseResponse(ctx->accept, ctx->acceptlen)==0)
+	{
+		RadiusSamples::decodeResponse(ctx->request);
+	}
+}
+
+static void decodeAccessAcceptAttributes(BenchmarkContext *ctx)
+{
+	pair<multimap<Octet,RadiusAttribute>::iterator,multimap<Octet,RadiusAttribute>::iterator> range;
+	string routes;
+	
+	if (ctx->request->radiusParseResponse(ctx->accept, ctx->acceptlen)==0)
+	{
+		range=ctx->request->findAttributes(ATTRIB_Framed_Route);
+		for (multimap<Octet,RadiusAttribute>::iterator it=range.first; it!=range.second; it++)
+		{
+			routes.append((const char *) it->second.getValue(), it->second.getLength()-2);
+			routes.append(";");
+		}
+	}
+}
+
+static void decodeAccountingResponse(BenchmarkContext *ctx)
+{
+	if (ctx->acctrequest->radiusParseResponse(ctx->acctresponse, ctx->acctresponselen)==0)
+	{
+		RadiusSamples::decodeResponse(ctx->acctrequest);
+	}
+}
+
+static void decodeVendorSpecific(BenchmarkContext *ctx)
+{
+	RadiusSamples::decodeVendorSpecific(ctx->vsa, ctx->vsalen);
+}
+
+/** Runs a test and prints the time and the allocations per operation.
+ * @param name The name of the test.
+ * @param func The test.
+ * @param ctx The data of the tests.
+ * @param n The number of operations.
+ */
+static void run(const char *name, BenchmarkFunction func, BenchmarkContext *ctx, int n)
+{
+	struct timespec	start, end;
+	unsigned long	count;
+	double			ns;
+	int				i;
+	
+	//warm up the caches
+	for (i=0; i<n/10; i++)
+	{
+		func(ctx);
+	}
+	
+	count=allocations;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i=0; i<n; i++)
+	{
+		func(ctx);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	count=allocations-count;
+	ns=(end.tv_sec-start.tv_sec)*1e9+(end.tv_nsec-start.tv_nsec);
+	printf("%-44s %10.1f ns/op %8.2f allocs/op\n", name, ns/n, (double) count/n);
+}
+
+int main(int argc, char **argv)
+{
+	BenchmarkContext	ctx;
+	char				name[64];
+	int					n=100000, routes=16, vsas=8, c;
+	
+	while ((c=getopt(argc, argv, "n:r:v:"))!=-1)
+	{
+		switch (c)
+		{
+			case 'n':
+				n=atoi(optarg);
+				break;
+			case 'r':
+				routes=atoi(optarg);
+				break;
+			case 'v':
+				vsas=atoi(optarg);
+				break;
+			default:
+				fprintf(stderr, "usage: %s [-n iterations] [-r routes] [-v vsas]\n", argv[0]);
+				return 1;
+		}
+	}
+	if (n<=0)
+	{
+		n=1;
+	}
+	
+	RadiusCrypto::init();
+	ctx.server=new RadiusServer("127.0.0.1", "testing123");
+	
+	//the responses are built for shaped requests
+	ctx.request=new RadiusPacket(ACCESS_REQUEST);
+	RadiusSamples::accessRequest(ctx.request);
+	ctx.request->radiusShape(ctx.server, 0);
+	ctx.acceptlen=RadiusSamples::response(ctx.accept, ACCESS_ACCEPT, ctx.request, ctx.server, routes, vsas);
+	
+	ctx.acctrequest=new RadiusPacket(ACCOUNTING_REQUEST);
+	RadiusSamples::accountingRequest(ctx.acctrequest);
+	ctx.acctrequest->radiusShape(ctx.server, 0);
+	ctx.acctresponselen=RadiusSamples::response(ctx.acctresponse, ACCOUNTING_RESPONSE, ctx.acctrequest, ctx.server, 0, 0);
+	
+	//Cisco-AVPair
+	memcpy(ctx.vsa, "\x00\x00\x00\x09\x01\x1e" "ip:inacl#1=permit ip any any", 34);
+	ctx.vsalen=34;
+	
+	run("encode Access-Request", encodeAccessRequest, &ctx, n);
+	run("encode Access-Request (RadiusAttribute)", encodeAccessRequestAttributes, &ctx, n);
+	run("encode Accounting-Request", encodeAccountingRequest, &ctx, n);
+	run("makePasswordHash (shared secret)", hidePasswordSecret, &ctx, n);
+	run("makePasswordHash (RadiusCrypto)", hidePasswordCrypto, &ctx, n);
+	snprintf(name, sizeof(name), "decode Access-Accept (%d routes, %d vsas)", routes, vsas);
+	run(name, decodeAccessAccept, &ctx, n);
+	run("decode Access-Accept (findAttributes)", decodeAccessAcceptAttributes, &ctx, n);
+	run("decode Accounting-Response", decodeAccountingResponse, &ctx, n);
+	run("decode Vendor-Specific", decodeVendorSpecific, &ctx, n);
+	
+	delete ctx.acctrequest;
+	delete ctx.request;
+	delete ctx.server;
+	return 0;
+}
@@ -0,0 +1,249 @@
+/*
+ *  RadiusClass -- An C++-Library for radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+
+/* The fuzzer decodes the input as the response of a server on an Access-Request,
+ * like the authentication process does it. The response authenticator of the 
+ * input is replaced by the right one, so the input gets through the 
+ * authentication to the decoder.
+ * 
+ * The seed corpus is written by make fuzz-corpus into RadiusClass/benchmark/corpus.
+ * 
+ * libFuzzer: make fuzz CXX=clang++ CXXFLAGS="-g -O1 -fsanitize=fuzzer-no-link,address" \
+ *				FUZZFLAGS="-fsanitize=fuzzer,address -DRADIUS_LIBFUZZER"
+ *			  ./fuzz RadiusClass/benchmark/corpus
+ * AFL:		  make fuzz CXX=afl-clang-fast++
+ *			  afl-fuzz -i RadiusClass/benchmark/corpus -o findings -- ./fuzz @@
+ * 
+ * usage without libFuzzer: fuzz [file ...]	decodes the files or the standard input
+ *							fuzz -w directory	writes the seed corpus into the directory
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "RadiusSamples.h"
+
+static RadiusServer		*server=NULL;	/**<The server with the shared secret.*/
+static RadiusPacket		*request=NULL;	/**<The request for the responses.*/
+static Octet			authenticator[RADIUS_PACKET_AUTHENTICATOR_LEN];	/**<The authenticator of the request.*/
+
+/** Shapes the request once.*/
+static void init(void)
+{
+	if (server!=NULL)
+	{
+		return;
+	}
+	RadiusCrypto::init();
+	server=new RadiusServer("127.0.0.1", "testing123");
+	request=new RadiusPacket(ACCESS_REQUEST);
+	RadiusSamples::accessRequest(request);
+	request->radiusShape(server, 0);
+	memcpy(authenticator, request->getAuthenticator(), RADIUS_PACKET_AUTHENTICATOR_LEN);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	Octet	buf[RADIUS_MAX_PACKET_LEN];
+	int		len;
+	string	routes;
+	pair<multimap<Octet,RadiusAttribute>::iterator,multimap<Octet,RadiusAttribute>::iterator> range;
+	
+	init();
+	if (size>RADIUS_MAX_PACKET_LEN)
+	{
+		return 0;
+	}
+	memcpy(buf, data, size);
+	
+	//sign the input, if the length field is valid
+	if (size>=20)
+	{
+		len=buf[2]*256+buf[3];
+		if (len>=20 && len<=(int)size)
+		{
+			RadiusSamples::sign(buf, len, authenticator, server);
+		}
+	}
+	
+	if (request->radiusParseResponse(buf, size)!=0)
+	{
+		return 0;
+	}
+	RadiusSamples::decodeResponse(request);
+	
+	//the attributes are copied into the multimap
+	range=request->findAttributes(ATTRIB_Framed_Route);
+	for (multimap<Octet,RadiusAttribute>::iterator it=range.first; it!=range.second; it++)
+	{
+		routes.append((const char *) it->second.getValue(), it->second.getLength()-2);
+	}
+	return 0;
+}
+
+#ifndef RADIUS_LIBFUZZER
+
+/** Appends an attribute to a seed.
+ * @param buf The seed.
+ * @param pos The length of the seed, it is incremented.
+ * @param type The type of the attribute.
+ * @param value The value.
+ * @param len The length of the value.
+ */
+static void put(Octet *buf, int *pos, Octet type, const char *value, int len)
+{
+	buf[(*pos)++]=type;
+	buf[(*pos)++]=len+2;
+	memcpy(buf+*pos, value, len);
+	*pos+=len;
+}
+
+/** Writes a seed into the corpus, the length field is set to the length of the seed.
+ * @param dir The directory of the corpus.
+ * @param name The name of the file.
+ * @param buf The seed.
+ * @param len The length of the seed.
+ * @return 0 if the file is written, else 1.
+ */
+static int writeSeed(const char *dir, const char *name, Octet *buf, int len)
+{
+	char	path[1024];
+	FILE	*file;
+	
+	buf[1]=(Octet)request->getIdentifier();
+	buf[2]=(Octet)(len>>8);
+	buf[3]=(Octet)len;
+	snprintf(path, sizeof(path), "%s/%s", dir, name);
+	if (!(file=fopen(path, "wb")))
+	{
+		perror(path);
+		return 1;
+	}
+	fwrite(buf, 1, len, file);
+	fclose(file);
+	return 0;
+}
+
+/** Writes the seed corpus: the responses of the benchmark and responses 
+ * with other codes and attributes.
+ * @param dir The directory of the corpus, it must exist.
+ * @return 0 if the seeds are written, else 1.
+ */
+static int writeCorpus(const char *dir)
+{
+	Octet	buf[RADIUS_MAX_PACKET_LEN];
+	int		len, err=0;
+	
+	len=RadiusSamples::response(buf, ACCESS_ACCEPT, request, server, 0, 0);
+	err|=writeSeed(dir, "access-accept", buf, len);
+	len=RadiusSamples::response(buf, ACCESS_ACCEPT, request, server, 16, 8);
+	err|=writeSeed(dir, "access-accept-routes", buf, len);
+	len=RadiusSamples::response(buf, ACCESS_ACCEPT, request, server, 200, 40);
+	err|=writeSeed(dir, "access-accept-full", buf, len);
+	len=RadiusSamples::response(buf, ACCOUNTING_RESPONSE, request, server, 0, 0);
+	err|=writeSeed(dir, "accounting-response", buf, len);
+	
+	memset(buf, 0, 20);
+	buf[0]=ACCESS_REJECT;
+	len=20;
+	put(buf, &len, ATTRIB_Reply_Message, "Authentication failed", 21);
+	err|=writeSeed(dir, "access-reject", buf, len);
+	
+	buf[0]=ACCESS_CHALLENGE;
+	len=20;
+	put(buf, &len, ATTRIB_State, "challenge-4711", 14);
+	put(buf, &len, ATTRIB_Reply_Message, "Enter the token", 15);
+	put(buf, &len, ATTRIB_Message_Authenticator, "0123456789abcdef", 16);
+	err|=writeSeed(dir, "access-challenge", buf, len);
+	
+	buf[0]=ACCESS_ACCEPT;
+	len=20;
+	put(buf, &len, ATTRIB_Framed_IPv6_Address, "\x20\x01\x0d\xb8\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x06", 16);
+	put(buf, &len, ATTRIB_Framed_IPv6_Route, "2001:db8:1::/64 :: 1", 20);
+	put(buf, &len, ATTRIB_Framed_IP_Address, "\x0a\x08", 2);
+	put(buf, &len, ATTRIB_Acct_Interim_Interval, "\x00\x3c", 2);
+	err|=writeSeed(dir, "access-accept-ipv6", buf, len);
+	
+	//vendor specific attributes with more sub attributes and bad lengths
+	len=20;
+	put(buf, &len, ATTRIB_Vendor_Specific, "\x00\x00\x00\x09\x01\x05" "abc" "\xbb\x06\x00\x00\x00\x01", 15);
+	put(buf, &len, ATTRIB_Vendor_Specific, "\x00\x00\x01\x37\x1c\x08\x0a\x00\x00\x01\x02\x03", 12);
+	put(buf, &len, ATTRIB_Vendor_Specific, "\x00\x00\x00\x09\x01\x01", 6);
+	put(buf, &len, ATTRIB_Vendor_Specific, "\x00\x00", 2);
+	err|=writeSeed(dir, "access-accept-vsa", buf, len);
+	
+	//an attribute with a length below 2
+	len=20;
+	put(buf, &len, ATTRIB_Class, "class", 5);
+	buf[len++]=ATTRIB_Framed_Route;
+	buf[len++]=1;
+	err|=writeSeed(dir, "bad-attribute-length", buf, len);
+	return err;
+}
+
+/** Reads a file and decodes it.
+ * @param file The file.
+ * @return 0 if the file is read, else 1.
+ */
+static int decodeFile(FILE *file)
+{
+	Octet	buf[RADIUS_MAX_PACKET_LEN+1];
+	size_t	len;
+	
+	len=fread(buf, 1, sizeof(buf), file);
+	if (ferror(file))
+	{
+		return 1;
+	}
+	LLVMFuzzerTestOneInput(buf, len);
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	FILE	*file;
+	int		i, err=0;
+	
+	init();
+	if (argc==3 && strcmp(argv[1], "-w")==0)
+	{
+		return writeCorpus(argv[2]);
+	}
+	if (argc==1)
+	{
+		return decodeFile(stdin);
+	}
+	for (i=1; i<argc; i++)
+	{
+		if (!(file=fopen(argv[i], "rb")))
+		{
+			perror(argv[i]);
+			err=1;
+			continue;
+		}
+		err|=decodeFile(file);
+		fclose(file);
+	}
+	return err;
+}
+
+#endif //RADIUS_LIBFUZZER
@@ -0,0 +1,148 @@
+/*
+ *  RadiusClass -- An C++-Library for radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+
+/* The test compares the hashes of RadiusMd5::digest() with libgcrypt. The
+ * messages are hashed with 1, 4 and 8 lanes, their lengths are around the 
+ * padding boundaries of MD5 (55/56 and 63/64 octets in the last block), 
+ * the lanes of a group get different lengths, too.
+ * 
+ * usage: make md5test, the exit code is 1 if a hash is wrong.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gcrypt.h>
+#include "../RadiusCrypto.h"
+#include "../RadiusMd5.h"
+
+#define MD5TEST_MAX_VALUES	24		/**<The maximum number of values of one call.*/
+#define MD5TEST_MAX_LEN		300		/**<The maximum length of a value.*/
+#define MD5TEST_MAX_SUFFIX	40		/**<The maximum length of the suffix.*/
+
+static Octet	input[MD5TEST_MAX_VALUES][MD5TEST_MAX_LEN];	/**<The values.*/
+static Octet	suffix[MD5TEST_MAX_SUFFIX];					/**<The suffix.*/
+static int		tests=0;									/**<The number of compared hashes.*/
+static int		errors=0;									/**<The number of wrong hashes.*/
+
+/** Hashes the values with RadiusMd5 and compares the hashes with libgcrypt.
+ * @param count The number of values.
+ * @param lens The lengths of the values.
+ * @param suffixlen The length of the suffix.
+ * @param lanes The lanes for RadiusMd5::digest().
+ */
+static void check(int count, const int *lens, int suffixlen, int lanes)
+{
+	const Octet	*values[MD5TEST_MAX_VALUES];
+	Octet		digest[MD5TEST_MAX_VALUES][16], *digests[MD5TEST_MAX_VALUES];
+	Octet		buf[MD5TEST_MAX_LEN+MD5TEST_MAX_SUFFIX], expected[16];
+	int			i;
+	
+	for (i=0; i<count; i++)
+	{
+		values[i]=input[i];
+		digests[i]=digest[i];
+	}
+	RadiusMd5::digest(count, values, lens, suffix, suffixlen, digests, lanes);
+	
+	for (i=0; i<count; i++)
+	{
+		memcpy(buf, input[i], lens[i]);
+		memcpy(buf+lens[i], suffix, suffixlen);
+		gcry_md_hash_buffer(GCRY_MD_MD5, expected, buf, lens[i]+suffixlen);
+		tests++;
+		if (memcmp(expected, digest[i], 16)!=0)
+		{
+			errors++;
+			fprintf(stderr, "wrong hash: lanes %d, value %d of %d, length %d, suffix %d\n", 
+				lanes, i, count, lens[i], suffixlen);
+		}
+	}
+}
+
+int main(void)
+{
+	//the lengths of the last block around the padding boundaries
+	const int	bounds[]={0, 1, 54, 55, 56, 57, 63, 64, 65, 118, 119, 120, 121, 127, 128, 129};
+	const int	suffixes[]={0, 1, 16};
+	const int	lanes[]={1, 4, 8};
+	int			lens[MD5TEST_MAX_VALUES];
+	int			l, s, b, i, n, count;
+	
+	RadiusCrypto::init();
+	srand(1);
+	for (i=0; i<MD5TEST_MAX_VALUES; i++)
+	{
+		for (n=0; n<MD5TEST_MAX_LEN; n++)
+		{
+			input[i][n]=rand();
+		}
+	}
+	for (i=0; i<MD5TEST_MAX_SUFFIX; i++)
+	{
+		suffix[i]=rand();
+	}
+	
+	for (l=0; l<3; l++)
+	{
+		for (s=0; s<3; s++)
+		{
+			//all lanes with the same length
+			for (b=0; b<(int)(sizeof(bounds)/sizeof(bounds[0])); b++)
+			{
+				if (bounds[b]<suffixes[s])
+				{
+					continue;
+				}
+				for (i=0; i<MD5TEST_MAX_VALUES; i++)
+				{
+					lens[i]=bounds[b]-suffixes[s];
+				}
+				check(MD5TEST_MAX_VALUES, lens, suffixes[s], lanes[l]);
+			}
+			
+			//the lanes of a group end in different blocks
+			for (b=0; b<MD5TEST_MAX_LEN-MD5TEST_MAX_VALUES; b++)
+			{
+				for (i=0; i<MD5TEST_MAX_VALUES; i++)
+				{
+					lens[i]=b+i*7%MD5TEST_MAX_VALUES;
+				}
+				check(MD5TEST_MAX_VALUES, lens, suffixes[s], lanes[l]);
+			}
+		}
+		
+		//random counts and lengths
+		for (n=0; n<2000; n++)
+		{
+			count=1+rand()%MD5TEST_MAX_VALUES;
+			for (i=0; i<count; i++)
+			{
+				lens[i]=rand()%MD5TEST_MAX_LEN;
+			}
+			check(count, lens, rand()%MD5TEST_MAX_SUFFIX, lanes[l]);
+		}
+	}
+	
+	printf("md5test: %d lanes on this cpu, %d hashes, %d wrong\n", RadiusMd5::getLanes(), tests, errors);
+	return errors>0 ? 1 : 0;
+}
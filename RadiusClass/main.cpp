@@ -49,6 +49,8 @@
  * - For testing compile files with:
  * 		g++ -Wall -o main main.cpp RadiusAttribute.cpp RadiusPacket.cpp RadiusConfig.cpp RadiusServer.cpp RadiusVendorSpecificAttribute.cpp -lgcrypt 
  * - Integrate the library in your code (example implementation: main.cpp).
+ * - The encoding and decoding of packets is measured with make benchmark and fuzzed with make fuzz,
+ * 		see benchmark/benchmark.cpp and benchmark/fuzz.cpp.
  * 
  * \section TODO
  * - debug - class
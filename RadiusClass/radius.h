@@ -44,6 +44,7 @@ typedef	unsigned char	Octet;
 #define	RADIUS_PACKET_AUTHENTICATOR_LEN	16
 #define	RADIUS_MAX_PACKET_LEN			4096
 #define RADIUS_PACKET_IDENTIFIER_LEN	1
+#define RADIUS_MAX_PASSWORD_LEN		128
 #define MD5_DIGEST_LENGTH 16
 
 /** The radius packet codes */
@@ -143,6 +144,7 @@ typedef	unsigned char	Octet;
 #define ATTRIB_Login_IPv6_Host			98 //ipv6addr
 #define ATTRIB_Framed_IPv6_Route		99 //string
 #define ATTRIB_Framed_IPv6_Pool			100//string
+#define ATTRIB_Framed_IPv6_Address		168//ipv6addr
 
 
 #define	VALUE_Service_Type_Call_Check	"10"
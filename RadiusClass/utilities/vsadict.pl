@@ -0,0 +1,145 @@
+#!/usr/bin/perl -w
+
+# Generates the table of the vendor specific attributes for RadiusDictionary
+# from a dictionary file of freeradius. The table is found with a perfect
+# hash over (vendor, type), see RadiusDictionary.cpp for the hash function.
+#
+# usage: vsadict.pl dictionary > vsadict.h
+
+use strict;
+
+my %datatypes = ('integer' => 'RADIUS_VSA_INTEGER', 'date' => 'RADIUS_VSA_DATE',
+	'string' => 'RADIUS_VSA_STRING', 'ipaddr' => 'RADIUS_VSA_IPADDR');
+
+my $file = $ARGV[0] || 'dictionary';
+open(FILE, "<$file") || die "File $file not found";
+my @lines = <FILE>;
+close(FILE);
+
+my %vendors;
+my @entries;
+my %keys;
+foreach (@lines)
+{
+	s/#.*//;
+	my @values = split(' ', $_);
+	next if (!@values);
+	if ($values[0] eq 'VENDOR' && @values >= 3)
+	{
+		$vendors{$values[1]} = $values[2];
+	}
+	elsif ($values[0] eq 'ATTRIBUTE' && @values >= 5)
+	{
+		die "Unknown vendor $values[4]" if (!defined($vendors{$values[4]}));
+		my $vendor = $vendors{$values[4]};
+		my $type = $values[2] =~ /^0x/i ? hex($values[2]) : $values[2];
+		# the first definition is taken, like in the old if-statements
+		next if (defined($keys{"$vendor:$type"}));
+		$keys{"$vendor:$type"} = 1;
+		push(@entries, {'vendor' => $vendor, 'type' => $type, 'name' => $values[1],
+			'datatype' => $datatypes{$values[3]} || 'RADIUS_VSA_OTHER'});
+	}
+}
+
+# multiplication modulo 2^32 without overflow
+sub mul32
+{
+	my ($a, $b) = @_;
+	return (($a * ($b & 0xffff)) + ((($a * ($b >> 16)) & 0xffff) << 16)) & 0xffffffff;
+}
+
+# the same function as hashKey() in RadiusDictionary.cpp
+sub hashkey
+{
+	my ($vendor, $type, $seed) = @_;
+	my $h = mul32($seed, 0x9e3779b9) ^ $vendor;
+	$h = mul32($h, 0x01000193) ^ $type;
+	$h = mul32($h, 0x01000193);
+	$h ^= $h >> 15;
+	$h = mul32($h, 0x2c1b3c6d);
+	$h ^= $h >> 12;
+	return $h;
+}
+
+# the sizes are powers of 2, a bucket has up to 4 keys in average
+my $n = @entries;
+my $size = 1;
+$size <<= 1 while ($size < $n);
+my $buckets = 1;
+$buckets <<= 1 while ($buckets < $n / 4);
+
+# hash and displace: the keys of a bucket are placed with the first
+# seed which gives free slots, the biggest buckets are placed first
+my @bucket;
+for (my $i = 0; $i < $n; $i++)
+{
+	push(@{$bucket[hashkey($entries[$i]{'vendor'}, $entries[$i]{'type'}, 0) & ($buckets - 1)]}, $i);
+}
+my @displacement = (0) x $buckets;
+my @slot = (0) x $size;
+foreach my $b (sort { scalar(@{$bucket[$b] || []}) <=> scalar(@{$bucket[$a] || []}) || $a <=> $b } (0 .. $buckets - 1))
+{
+	next if (!defined($bucket[$b]));
+	my $seed;
+	for ($seed = 1; $seed < 65536; $seed++)
+	{
+		my %used;
+		my $ok = 1;
+		foreach my $i (@{$bucket[$b]})
+		{
+			my $s = hashkey($entries[$i]{'vendor'}, $entries[$i]{'type'}, $seed) & ($size - 1);
+			if ($slot[$s] || $used{$s})
+			{
+				$ok = 0;
+				last;
+			}
+			$used{$s} = 1;
+		}
+		last if ($ok);
+	}
+	die "No perfect hash found" if ($seed >= 65536);
+	$displacement[$b] = $seed;
+	foreach my $i (@{$bucket[$b]})
+	{
+		$slot[hashkey($entries[$i]{'vendor'}, $entries[$i]{'type'}, $seed) & ($size - 1)] = $i + 1;
+	}
+}
+
+print "/* File was generated from the dictionary file of freeradius with vsadict.pl, don't edit it. */\n";
+print "#ifndef _VSADICT_H_\n";
+print "#define _VSADICT_H_\n\n";
+print "/** The number of attributes in the dictionary.*/\n";
+print "#define VSADICT_ENTRIES\t$n\n";
+print "/** The number of displacements, a power of 2.*/\n";
+print "#define VSADICT_BUCKETS\t$buckets\n";
+print "/** The number of slots of the hash table, a power of 2.*/\n";
+print "#define VSADICT_SIZE\t$size\n\n";
+
+print "/** The attributes of the dictionary.*/\n";
+print "static const RadiusDictionaryEntry vsadict_entries[VSADICT_ENTRIES]=\n{\n";
+foreach my $e (@entries)
+{
+	print "\t{$e->{'vendor'}, $e->{'type'}, $e->{'datatype'}, \"$e->{'name'}\"},\n";
+}
+print "};\n\n";
+
+print "/** The seeds of the buckets for the hash of the slot.*/\n";
+print "static const unsigned short vsadict_displacement[VSADICT_BUCKETS]=\n{\n";
+for (my $i = 0; $i < $buckets; $i += 16)
+{
+	my $last = $i + 15 < $buckets - 1 ? $i + 15 : $buckets - 1;
+	print "\t", join(", ", @displacement[$i .. $last]), ",\n";
+}
+print "};\n\n";
+
+print "/** The slots of the hash table, the index of the attribute plus 1, 0 if the slot is empty.*/\n";
+print "static const unsigned short vsadict_slot[VSADICT_SIZE]=\n{\n";
+for (my $i = 0; $i < $size; $i += 16)
+{
+	my $last = $i + 15 < $size - 1 ? $i + 15 : $size - 1;
+	print "\t", join(", ", @slot[$i .. $last]), ",\n";
+}
+print "};\n\n";
+print "#endif //_VSADICT_H_\n";
+
+exit(0);
@@ -79,6 +79,8 @@ User & User::operator=(const User & u)
 	this->framedroutes=u.framedroutes;
 	this->framedip6=u.framedip6;
 	this->framedroutes6=u.framedroutes6;
+	this->routes=u.routes;
+	this->routes6=u.routes6;
 	this->key=u.key;
         this->statusfilekey=u.statusfilekey;
 	this->callingstationid=u.callingstationid;
@@ -122,6 +124,8 @@ User::User(const User & u)
 	this->framedroutes=u.framedroutes;
 	this->framedip6=u.framedip6;
 	this->framedroutes6=u.framedroutes6;
+	this->routes=u.routes;
+	this->routes6=u.routes6;
 	this->key=u.key;
         this->statusfilekey=u.statusfilekey;
 	this->callingstationid=u.callingstationid;
@@ -194,12 +198,14 @@ string User::getFramedRoutes(void)
 {
 	return this->framedroutes;
 }
-/** The setter method for the framedroutes.
+/** The setter method for the framedroutes, the routes are parsed
+ * once here, see getRoutes().
  * @param froutes The framedroutes, if there are more 
  * routes they are divided through a ';'.*/
 void User::setFramedRoutes(string froutes)
 {
 	this->framedroutes=froutes;
+	FramedRoute::parseList(AF_INET,froutes,&this->routes);
 }
 
 /** The getter method for the framed ip.
@@ -221,12 +227,28 @@ string User::getFramedRoutes6(void)
 {
 	return this->framedroutes6;
 }
-/** The setter method for the framed IPv6 routes.
+/** The setter method for the framed IPv6 routes, the routes are parsed
+ * once here, see getRoutes6().
  * @param froutes6 The framed IPv6 routes, if there are more 
  * routes they are divided through a ';'.*/
 void User::setFramedRoutes6(string froutes6)
 {
 	this->framedroutes6=froutes6;
+	FramedRoute::parseList(AF_INET6,froutes6,&this->routes6);
+}
+
+/** The getter method for the parsed framed routes.
+ * @return A reference to the valid routes of the framedroutes.*/
+const vector<FramedRoute> & User::getRoutes(void)
+{
+	return this->routes;
+}
+
+/** The getter method for the parsed framed IPv6 routes.
+ * @return A reference to the valid routes of the framedroutes6.*/
+const vector<FramedRoute> & User::getRoutes6(void)
+{
+	return this->routes6;
 }
 
 /** The getter method for the framed IPv6.
@@ -334,7 +356,7 @@ void User::setUntrustedPort(string port)
  * @return 0 in case of no error.
  */
 
-int User::appendVsaBuf(Octet *value, unsigned int len)
+int User::appendVsaBuf(const Octet *value, unsigned int len)
 {
 	if(this->vsabuf == NULL)
 	{	
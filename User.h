@@ -25,6 +25,8 @@
 #include <iostream>
 #include <cstdio>
 #include <cstring>
+#include <vector>
+#include "FramedRoute.h"
 //#include "radiusplugin.h"
 //#include "openvpn-plugin.h"
 
@@ -50,6 +52,8 @@ protected:
 	string framedip;		/**<The framed ip.*/
 	string framedroutes6;		/**<The framed IPv6 routes, they are stored as a string. If there are more routes, they must be delimited by an ';'*/
 	string framedip6;		/**<The framed ipv6.*/
+	vector<FramedRoute> routes;	/**<The parsed framedroutes, they are set by setFramedRoutes().*/
+	vector<FramedRoute> routes6;	/**<The parsed framedroutes6, they are set by setFramedRoutes6().*/
 	string callingstationid;	/**<The calling station id, in this case the real ip address of the client.*/
 	string key;			/**<A unique key to find the user in a map. */
 	string statusfilekey;		/**<Unique identifier in the status log file (version 1) "commonname,untrusted_ip:untrusted_port"*/
@@ -91,6 +95,9 @@ public:
 	string getFramedIp6(void);
 	void setFramedIp6(string);
 	
+	const vector<FramedRoute> & getRoutes(void);
+	const vector<FramedRoute> & getRoutes6(void);
+	
 	string getKey(void);
 	void setKey(string);
 
@@ -109,7 +116,7 @@ public:
 	string getUntrustedPort(void);
 	void setUntrustedPort(string);
 	
-	int appendVsaBuf(Octet *, unsigned int len);
+	int appendVsaBuf(const Octet *, unsigned int len);
 	Octet * getVsaBuf();
 	void setVsaBuf(Octet *);
 	
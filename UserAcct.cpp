@@ -53,6 +53,7 @@ UserAcct & UserAcct::operator=(const UserAcct &u)
 		this->bytesout=u.bytesout;
 		this->nextupdate=u.nextupdate;
 		this->starttime=u.starttime;
+		this->attributes=u.attributes;
 	}
 	return *this;
 }
@@ -71,194 +72,181 @@ UserAcct::UserAcct(const UserAcct &u):User(u)
 	this->bytesout=u.bytesout;
 	this->nextupdate=u.nextupdate;
 	this->starttime=u.starttime;
+	this->attributes=u.attributes;
 	
 }
 
-/** The method sends an accounting update packet for the user to the radius server.
- * The accounting information are read from the OpenVpn
- * status file. The following attributes are sent to the radius server:
+/** The method adds the attributes of the session to an accounting packet.
+ * The attributes are serialized only for the first packet of the session, 
+ * after that the template is copied into the packet and the Acct-Status-Type 
+ * and the counters at the end of the template are patched. The start packet 
+ * has no counters. The template has the following attributes:
  * - User_Name, 
  * - Framed_IP_Address,
  * - NAS_Port,
  * - Calling_Station_Id,
- * - NAS_Identifier,
- * - NAS_IP_Address,
- * - NAS_Port_Type,
- * - Service_Type,
  * - Acct_Session_ID,
+ * - the nas attributes of the config,
  * - Acct_Status_Type,
- * - Framed_Protocol,
  * - Acct_Input_Octets,
  * - Acct_Output_Octets,
  * - Acct_Session_Time,
  * - Acct_Input_Gigawords,
  * - Acct_Output_Gigawords
  * @param context The context of the plugin.
- * @return An integer, 0 is everything is ok, else 1.*/
-int UserAcct::sendUpdatePacket(PluginContext *context)
+ * @param packet The packet, the attributes are appended with the packet builder.
+ * @param status The value of the Acct-Status-Type.
+ * @return An integer, 0 if the attributes are added, else 1.*/
+int UserAcct::buildPacket(PluginContext *context, RadiusPacket *packet, uint32_t status)
 {
+	const Octet	*value;
+	int			pos,
+				len,
+				counters;
 	
-	list<RadiusServer> * serverlist;
-	list<RadiusServer>::iterator server;
-	
-	RadiusPacket		packet(ACCOUNTING_REQUEST);
-	RadiusAttribute		ra1(ATTRIB_User_Name,this->getUsername()),
-				ra2(ATTRIB_Framed_IP_Address,this->getFramedIp()),
-				ra3(ATTRIB_NAS_Port,this->getPortnumber()),
-				ra4(ATTRIB_Calling_Station_Id,this->getCallingStationId()),
-				ra5(ATTRIB_NAS_Identifier),
-				ra6(ATTRIB_NAS_IP_Address),
-				ra7(ATTRIB_NAS_Port_Type),
-				ra8(ATTRIB_Service_Type),
-				ra9(ATTRIB_Acct_Session_ID, this->getSessionId()),
-		                ra10(ATTRIB_Acct_Status_Type,string("3")), // "Alive"
-				ra11(ATTRIB_Framed_Protocol),
-				ra12(ATTRIB_Acct_Input_Octets, this->bytesin),
-				ra13(ATTRIB_Acct_Output_Octets, this->bytesout),
-				ra14(ATTRIB_Acct_Session_Time),
-				ra15(ATTRIB_Acct_Input_Gigawords, this->gigain),
-				ra16(ATTRIB_Acct_Output_Gigawords, this->gigaout);				
-	
-	
-	
-	//get the server list
-	serverlist=context->radiusconf.getRadiusServer();
-	
-	//set server on the first server
-	server=serverlist->begin();
-	
-	//add the attributes to the radius packet		
-	if(packet.addRadiusAttribute(&ra1))
+	if (this->attributes.empty())
 	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT: Fail to add attribute ATTRIB_User_Name.\n";
-	}
+		RadiusPacket tmpl;
 		
-	if (packet.addRadiusAttribute(&ra2))
-	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_User_Password.\n";
+		if (tmpl.appendAttribute(ATTRIB_User_Name, this->getUsername().c_str())<0)
+		{
+			cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_User_Name.\n";
+		}
+		if (tmpl.appendIpAddress(ATTRIB_Framed_IP_Address, this->getFramedIp().c_str())<0)
+		{
+			cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Framed_IP_Address.\n";
+		}
+		if (tmpl.appendInteger(ATTRIB_NAS_Port, this->getPortnumber())<0)
+		{
+			cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_NAS_Port.\n";
+		}
+		if (tmpl.appendAttribute(ATTRIB_Calling_Station_Id, this->getCallingStationId().c_str())<0)
+		{
+			cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Calling_Station_Id.\n";
+		}
+		if (tmpl.appendAttribute(ATTRIB_Acct_Session_ID, this->getSessionId().c_str())<0)
+		{
+			cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Acct_Session_ID.\n";
+		}
+		if (tmpl.appendAttributes((const Octet *)context->radiusconf.getAcctAttributes().data(), context->radiusconf.getAcctAttributes().size())<0)
+		{
+			cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add the nas attributes.\n";
+		}
+		//the values are patched for every packet
+		if (tmpl.appendInteger(ATTRIB_Acct_Status_Type, 0)<0 ||
+			tmpl.appendInteger(ATTRIB_Acct_Input_Octets, 0)<0 ||
+			tmpl.appendInteger(ATTRIB_Acct_Output_Octets, 0)<0 ||
+			tmpl.appendInteger(ATTRIB_Acct_Session_Time, 0)<0 ||
+			tmpl.appendInteger(ATTRIB_Acct_Input_Gigawords, 0)<0 ||
+			tmpl.appendInteger(ATTRIB_Acct_Output_Gigawords, 0)<0)
+		{
+			return 1;
+		}
+		len=tmpl.getAttributes(&value);
+		this->attributes.assign((const char *)value, len);
 	}
 	
-	if (packet.addRadiusAttribute(&ra3))
+	//every integer attribute has 6 octets, the status is followed by 5 counters
+	len=this->attributes.size();
+	counters=len-5*6;
+	if (status==1)
 	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_NAS_Port.\n";
+		len=counters;
 	}
-	
-	if (packet.addRadiusAttribute(&ra4))
+	pos=packet->appendAttributes((const Octet *)this->attributes.data(), len);
+	if (pos<0)
 	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Calling_Station_Id.\n";
+		return 1;
 	}
-	
-	//get the values from the config and add them to the packet
-	if(strcmp(context->radiusconf.getNASIdentifier(),""))
+	packet->setInteger(pos+counters-6+2, status);
+	if (status!=1)
 	{
-		ra5.setValue(context->radiusconf.getNASIdentifier());
-		if (packet.addRadiusAttribute(&ra5))
-		{
-			cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_NAS_Identifier.\n";
-		}
-	}
-		
-	if(strcmp(context->radiusconf.getNASIpAddress(),""))
-	{
-			if(ra6.setValue(context->radiusconf.getNASIpAddress())!=0)
-			{
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to set value ATTRIB_NAS_Ip_Address.\n";
-			}
-			if (packet.addRadiusAttribute(&ra6))
-			{
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_NAS_Ip_Address.\n";
-			}
+		packet->setInteger(pos+counters+2, this->bytesin);
+		packet->setInteger(pos+counters+6+2, this->bytesout);
+		packet->setInteger(pos+counters+12+2, time(NULL)-this->starttime);
+		packet->setInteger(pos+counters+18+2, this->gigain);
+		packet->setInteger(pos+counters+24+2, this->gigaout);
 	}
+	return 0;
+}
+
+/** The callback for the accounting update packets, it is called by the RadiusClient
+ * when the request is finished. The packet is freed here.
+ * @param packet The packet of the request.
+ * @param result The result of the request.
+ * @param arg The context of the plugin.
+ */
+static void updatePacketDone(RadiusPacket *packet, int result, void *arg)
+{
+	PluginContext *context=(PluginContext *)arg;
 	
-	if(strcmp(context->radiusconf.getNASPortType(),""))
+	//is the packet a ACCOUNTING_RESPONSE?
+	if (result==0 && packet->getCode()==ACCOUNTING_RESPONSE)
 	{
-			ra7.setValue(context->radiusconf.getNASPortType());
-			if (packet.addRadiusAttribute(&ra7))
-			{
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_NAS_Port_Type.\n";
-			}
+		if (DEBUG (context->getVerbosity()))
+			cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT: Get ACCOUNTING_RESPONSE-Packet.\n";
 	}
-	
-	if(strcmp(context->radiusconf.getServiceType(),""))
+	else if (result==0)
 	{
-			ra8.setValue(context->radiusconf.getServiceType());
-			if (packet.addRadiusAttribute(&ra8))
-			{
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Service_Type.\n";
-			}
+		if (DEBUG (context->getVerbosity()))
+			cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT: No response on accounting request.\n";
 	}
-	
-	if (packet.addRadiusAttribute(&ra9))
+	else
 	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Acct_Session_ID.\n";
+		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Error on receiving radius response, code: " <<  result << endl;
 	}
+	delete packet;
+}
+
+/** The method sends an accounting update packet for the user to the radius server.
+ * The packet is submitted to the RadiusClient of the context, the method doesn't wait
+ * for the response. The accounting information are read from the OpenVpn
+ * status file. The following attributes are sent to the radius server:
+ * - User_Name, 
+ * - Framed_IP_Address,
+ * - NAS_Port,
+ * - Calling_Station_Id,
+ * - NAS_Identifier,
+ * - NAS_IP_Address,
+ * - NAS_Port_Type,
+ * - Service_Type,
+ * - Acct_Session_ID,
+ * - Acct_Status_Type,
+ * - Framed_Protocol,
+ * - Acct_Input_Octets,
+ * - Acct_Output_Octets,
+ * - Acct_Session_Time,
+ * - Acct_Input_Gigawords,
+ * - Acct_Output_Gigawords
+ * @param context The context of the plugin.
+ * @return An integer, 0 if the packet was submitted, else 1.*/
+int UserAcct::sendUpdatePacket(PluginContext *context)
+{
 	
-	if (packet.addRadiusAttribute(&ra10))
-	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Acct_Session_ID.\n";
-	}
+	RadiusServerGroup * group;
 	
-	if(strcmp(context->radiusconf.getFramedProtocol(),""))
-	{
-			ra11.setValue(context->radiusconf.getFramedProtocol());
-			if (packet.addRadiusAttribute(&ra11))
-			{
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Framed_Protocol.\n";
-			}
-	}
+	//the attributes are copied from the template of the session directly
+	//into the buffer of the packet, only the counters are patched
+	RadiusPacket		*packet=new RadiusPacket(ACCOUNTING_REQUEST);
 	
-	if (packet.addRadiusAttribute(&ra12))
-	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Acct_Input_Packets.\n";
-	}
+	//get the server group
+	group=context->radiusconf.getAcctServerGroup(this->getUsername());
 	
-	if (packet.addRadiusAttribute(&ra13))
+	if (this->buildPacket(context, packet, 3)!=0) // "Alive"
 	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Acct_Output_Packets.\n";
-	}
-	//calculate the session time
-	ra14.setValue((time(NULL)-this->starttime));
-	if (packet.addRadiusAttribute(&ra14)) {
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Acct_Session_Time.\n";
-	}
-
-	if (packet.addRadiusAttribute(&ra15)) {
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Acct_Input_Gigawords.\n";
-	}
-
-	if (packet.addRadiusAttribute(&ra16)) {
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Acct_Output_Gigawords.\n";
+		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to build the packet.\n";
+		delete packet;
+		return 1;
 	}
 	
-	//send the packet to the server
-	if (packet.radiusSend(server)<0)
+	//submit the packet, the response is handled in updatePacketDone()
+	if (context->radiusclient.submit(packet, group, updatePacketDone, context)!=0)
 	{
 		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Packet was not sent.\n";
+		delete packet;
+		return 1;
 	}
-	
-	//get the response
-	if (packet.radiusReceive(serverlist)>=0)
-	{
-		//is the packet a ACCOUNTING_RESPONSE?
-		if(packet.getCode()==ACCOUNTING_RESPONSE)
-		{
-			if (DEBUG (context->getVerbosity()))
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT: Get ACCOUNTING_RESPONSE-Packet.\n";
-
-		
-			return 0;
-			
-		}
-		else
-		{
-			if (DEBUG (context->getVerbosity()))
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT: No response on accounting request.\n";
-			return 1;
-		}
-		
-		
-	}
-	return 1;
+	return 0;
 }
 
 /** The method sends an accounting start packet for the user to the radius server.
@@ -278,113 +266,21 @@ int UserAcct::sendUpdatePacket(PluginContext *context)
  * @return An integer, 0 is everything is ok, else 1.*/
 int UserAcct::sendStartPacket(PluginContext * context)
 {
-	list<RadiusServer>* serverlist;
-	list<RadiusServer>::iterator server;
+	RadiusServerGroup * group;
 	RadiusPacket		packet(ACCOUNTING_REQUEST);
-	RadiusAttribute		ra1(ATTRIB_User_Name,this->getUsername()),
-						ra2(ATTRIB_Framed_IP_Address,this->getFramedIp()),
-						ra3(ATTRIB_NAS_Port,this->getPortnumber()),
-						ra4(ATTRIB_Calling_Station_Id,this->getCallingStationId()),
-						ra5(ATTRIB_NAS_Identifier),
-						ra6(ATTRIB_NAS_IP_Address),
-						ra7(ATTRIB_NAS_Port_Type),
-						ra8(ATTRIB_Service_Type),
-						ra9(ATTRIB_Acct_Session_ID, this->getSessionId()),
-		                                ra10(ATTRIB_Acct_Status_Type,string("1")), // "Start"
-						ra11(ATTRIB_Framed_Protocol);
-				
-	
 	
 	//get the radius server from the config
-	serverlist=context->radiusconf.getRadiusServer();
-	
-	//set server to the first from the list
-	server=serverlist->begin();
+	group=context->radiusconf.getAcctServerGroup(this->getUsername());
 	
 	//add the attributes to the packet
-	if(packet.addRadiusAttribute(&ra1))
-	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_User_Name.\n";
-	}
-	
-	if (packet.addRadiusAttribute(&ra2))
-	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_User_Password.\n";
-	}
-	if (packet.addRadiusAttribute(&ra3))
-	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_NAS_Port.\n";
-	}
-	if (packet.addRadiusAttribute(&ra4))
-	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Calling_Station_Id.\n";
-	}
-	
-	//get information from the config and add the attributes to the packet
-	if(strcmp(context->radiusconf.getNASIdentifier(),""))
-	{
-			ra5.setValue(context->radiusconf.getNASIdentifier());
-			if (packet.addRadiusAttribute(&ra5))
-			{
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_NAS_Identifier.\n";
-			}
-	}
-	
-	if(strcmp(context->radiusconf.getNASIpAddress(),""))
-	{
-			if(ra6.setValue(context->radiusconf.getNASIpAddress())!=0)
-			{
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to set value ATTRIB_NAS_Ip_Address.\n";
-			}
-	
-			if (packet.addRadiusAttribute(&ra6))
-			{
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_NAS_Ip_Address.\n";
-			}
-	}
-	if(strcmp(context->radiusconf.getNASPortType(),""))
-	{
-			ra7.setValue(context->radiusconf.getNASPortType());
-			if (packet.addRadiusAttribute(&ra7))
-			{
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_NAS_Port_Type.\n";
-			}
-	}
-	
-	if(strcmp(context->radiusconf.getServiceType(),""))
-	{
-			ra8.setValue(context->radiusconf.getServiceType());
-			if (packet.addRadiusAttribute(&ra8))
-			{
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Service_Type.\n";
-			}
-	}
-	
-	if (packet.addRadiusAttribute(&ra9)) {
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Acct_Session_ID.\n";
-	}
-	
-	if (packet.addRadiusAttribute(&ra10)) {
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Acct_Session_ID.\n";
-	}
-	
-	if(strcmp(context->radiusconf.getFramedProtocol(),""))
-	{
-			ra11.setValue(context->radiusconf.getFramedProtocol());
-			if (packet.addRadiusAttribute(&ra11))
-			{
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Framed_Protocol.\n";
-			}
-	}
-	
-	//send the packet	
-	if (packet.radiusSend(server)<0)
+	if (this->buildPacket(context, &packet, 1)!=0) // "Start"
 	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Packet was not sent.\n";
+		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to build the packet.\n";
+		return 1;
 	}
 	
-	//receive the response
-	int ret=packet.radiusReceive(serverlist);
+	//send the packet and receive the response
+	int ret=context->radiusclient.sendRequest(&packet, group);
 	if (ret>=0)
 	{
 		//is is a accounting resopnse ?
@@ -435,143 +331,21 @@ int UserAcct::sendStartPacket(PluginContext * context)
  * @return An integer, 0 is everything is ok, else 1.*/
 int UserAcct::sendStopPacket(PluginContext * context)
 {
-	list<RadiusServer> * serverlist;
-	list<RadiusServer>::iterator server;
+	RadiusServerGroup * group;
 	RadiusPacket		packet(ACCOUNTING_REQUEST);
-	RadiusAttribute		ra1(ATTRIB_User_Name,this->getUsername()),
-				ra2(ATTRIB_Framed_IP_Address,this->getFramedIp()),
-				ra3(ATTRIB_NAS_Port,this->portnumber),
-				ra4(ATTRIB_Calling_Station_Id,this->getCallingStationId()),
-				ra5(ATTRIB_NAS_Identifier),
-				ra6(ATTRIB_NAS_IP_Address),
-				ra7(ATTRIB_NAS_Port_Type),
-				ra8(ATTRIB_Service_Type),
-				ra9(ATTRIB_Acct_Session_ID, this->getSessionId()),
-		                ra10(ATTRIB_Acct_Status_Type,string("2")), // "Stop"
-				ra11(ATTRIB_Framed_Protocol),
-				ra12(ATTRIB_Acct_Input_Octets, this->bytesin),
-				ra13(ATTRIB_Acct_Output_Octets, this->bytesout),
-				ra14(ATTRIB_Acct_Session_Time),
-				ra15(ATTRIB_Acct_Input_Gigawords, this->gigain),
-				ra16(ATTRIB_Acct_Output_Gigawords, this->gigaout);				
-	
-	
 		
 	//get the server from the config
-	serverlist=context->radiusconf.getRadiusServer();
-	
-	//set server to the first server
-	server=serverlist->begin();
+	group=context->radiusconf.getAcctServerGroup(this->getUsername());
 	
 	//add the attributes to the packet
-	if(packet.addRadiusAttribute(&ra1))
-	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_User_Name.\n";
-	}
-	
-	if (packet.addRadiusAttribute(&ra2))
-	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_FramedIP_Address.\n";
-	}
-	if (packet.addRadiusAttribute(&ra3))
-	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_NAS_Port.\n";
-	}
-	if (packet.addRadiusAttribute(&ra4))
+	if (this->buildPacket(context, &packet, 2)!=0) // "Stop"
 	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Calling_Station_Id.\n";
+		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to build the packet.\n";
+		return 1;
 	}
 	
-	//get information from th config and ad it to the packet
-	if(strcmp(context->radiusconf.getNASIdentifier(),""))
-	{
-			ra5.setValue(context->radiusconf.getNASIdentifier());
-			if (packet.addRadiusAttribute(&ra5))
-			{
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_NAS_Identifier.\n";
-			}
-	}
-	
-	if(strcmp(context->radiusconf.getNASIpAddress(),""))
-	{
-			if(ra6.setValue(context->radiusconf.getNASIpAddress())!=0)
-			{
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to set value ATTRIB_NAS_Ip_Address.\n";
-			}
-			else
-			if (packet.addRadiusAttribute(&ra6))
-			{
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_NAS_Ip_Address.\n";
-			}
-	}
-	if(strcmp(context->radiusconf.getNASPortType(),""))
-	{
-			ra7.setValue(context->radiusconf.getNASPortType());
-			if (packet.addRadiusAttribute(&ra7))
-			{
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_NAS_Port_Type.\n";
-			}
-	}
-	
-	if(strcmp(context->radiusconf.getServiceType(),""))
-	{
-			ra8.setValue(context->radiusconf.getServiceType());
-			if (packet.addRadiusAttribute(&ra8))
-			{
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Service_Type.\n";
-			}
-	}
-	if (packet.addRadiusAttribute(&ra9))
-	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Acct_Session_ID.\n";
-	}
-	if (packet.addRadiusAttribute(&ra10))
-	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Acct_Session_ID.\n";
-	}
-	
-	if(strcmp(context->radiusconf.getFramedProtocol(),""))
-	{
-			ra11.setValue(context->radiusconf.getFramedProtocol());
-			if (packet.addRadiusAttribute(&ra11))
-			{
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Framed_Protocol.\n";
-			}
-	}
-	
-	
-	
-	if (packet.addRadiusAttribute(&ra12))
-	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Acct_Input_Packets.\n";
-	}
-	if (packet.addRadiusAttribute(&ra13))
-	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Acct_Output_Packets.\n";
-	}
-	
-	//calculate the session time
-	ra14.setValue(time(NULL)-this->starttime);
-	if (packet.addRadiusAttribute(&ra14)) {
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Acct_Session_Time.\n";
-	}
-
-	if (packet.addRadiusAttribute(&ra15)) {
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Acct_Input_Gigawords.\n";
-	}
-
-	if (packet.addRadiusAttribute(&ra16)) {
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Fail to add attribute ATTRIB_Acct_Output_Gigawords.\n";
-	}
-	
-	//send the packet
-	if (packet.radiusSend(server)<0)
-	{
-		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Packet was not sent.\n";
-	}
-	
-	//get the response
-	if (packet.radiusReceive(serverlist)>=0)
+	//send the packet and get the response
+	if (context->radiusclient.sendRequest(&packet, group)>=0)
 	{
 		//is it an accounting response
 		if(packet.getCode()==ACCOUNTING_RESPONSE)
@@ -598,305 +372,7 @@ int UserAcct::sendStopPacket(PluginContext * context)
  */
 void UserAcct::delSystemRoutes(PluginContext * context)
 {
-	char * route;
-	char framedip[40];
-	
-	char routestring[200];
-	char framednetmask_cidr[4]; 
-	char framedgw[40];
-	char framedmetric[5];  
-	char * framedroutes, * framedroutes6;
-	int j=0,k=0,len=0;
-	
-	//copy the framed route string to an char array, it is easier to
-	//analyse
-	try{
-	  framedroutes=new char[this->getFramedRoutes().size()+1];
-	}
-	catch(...)
-	{
-	  cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND ACCT: New failed for framedroutes." << endl;
-	}
-	memset(framedroutes,0,this->getFramedRoutes().size()+1);
-	
-	// copy in a temp-string, because strtok deletes the delimiter, if it used anywhere
-	strncpy(framedroutes,this->getFramedRoutes().c_str(),this->getFramedRoutes().size());
-	
-	//are there framed routes
-	if (framedroutes[0]!='\0')
-	{
-		//get the first route
-		route=strtok(framedroutes,";");
-		len=strlen(route);
-		if (len > 50) //this is too big!! but the length is variable
-		{
-			cerr << getTime() <<"RADIUS-PLUGIN: BACKGROUND-ACCT:  Argument for Framed Route is too long (>50 Characters).\n";
-		}
-		else
-		{
-			while (route!=NULL)
-			{		
-				//set the arrays to 0
-				memset(routestring,0,100);
-				memset(framednetmask_cidr,0,3);
-				memset(framedip,0,16);
-				memset(framedgw,0,16);
-				memset(framedmetric,0,5);
-							
-				j=0;k=0;
-				//get ip address and add it to framedip
-				while(route[j]!='/' && j<len)
-				{
-					if (route[j]!=' ')
-					{
-						framedip[k]=route[j];
-						k++;
-					}
-					j++;
-				}
-				k=0;
-				j++;
-				//get the framednetmask and add it to framednetmack_cidr
-				while(route[j]!=' ' && j<=len)
-				{
-					framednetmask_cidr[k]=route[j];
-					k++;
-					j++;
-				}
-				k=0;
-				//jump spaces
-				while(route[j]==' ' && j<=len)
-				{
-					j++;
-				}
-				//get the gateway
-				while(route[j]!='/' && j<=len)
-				{
-					if (route[j]!=' ')
-					{
-						framedgw[k]=route[j];
-						k++;
-					}
-					j++;
-				}
-				j++;
-				//find gateway netmask (this isn't used
-				//at the command route under linux)
-				while(route[j]!=' ' && j<=len)
-				{
-					j++;
-				}
-				//jump spaces
-				while(route[j]==' ' && j<=len)
-				{
-					j++;
-				}
-				k=0;
-				if (j<=len) //is there a metric (optional)
-				{
-					k=0;
-					//find the metric
-					while(route[j]!=' ' && j<=len)
-					{
-							framedmetric[k]=route[j];
-							k++;
-							j++;
-					}
-				}
-															
-				//create system call
-				strncat(routestring, "ip route del ",13);
-				strncat(routestring, framedip ,16);
-				strncat(routestring, "/" ,1);
-				strncat(routestring, framednetmask_cidr, 2);
-				if (framedgw[0]!='\0')
-				{
-					strncat(routestring, " via ", 5);
-					strncat(routestring, framedgw, 16);
-				}
-				if (framedmetric[0]!='\0')
-				{
-					strncat(routestring, " metric ", 8);
-					strncat(routestring, framedmetric , 5);
-				}
-				strncat(routestring," dev ",5);
-				strcat(routestring,this->getDev().c_str());
-				strncat(routestring," proto static",13);
-				//redirect the output stderr to /dev/null
-				strncat(routestring," 2> /dev/null",13);
-				
-						
-				if (DEBUG (context->getVerbosity()))
-	    			cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Create route string "<< routestring <<".\n";
-				
-				//system call
-				if(system(routestring)!=0) 
-				//if(1)//-> the debugg can't context system()
-				{
-					cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Route " << routestring << " could not set. Route already set or bad route string.\n";
-				}
-				else
-				{
-					if (DEBUG (context->getVerbosity()))
-	    				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Add route to system routing table.\n";
-					
-				}
-				//get the next route
-				route=strtok(NULL,";");	
-			}
-		}
-		
-	}
-	else
-	{
-		if (DEBUG (context->getVerbosity()))
-    		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  No routes for user in AccessAcceptPacket.\n";
-	}
-	//free the char array
-	delete [] framedroutes;
-		
-
-	//copy the framed route string to an char array, it is easier to
-	//analyse
-	framedroutes6=new char[this->getFramedRoutes6().size()+1];
-	memset(framedroutes6,0,this->getFramedRoutes6().size()+1);
-	
-	// copy in a temp-string, because strtok deletes the delimiter, if it used anywhere
-	strncpy(framedroutes6,this->getFramedRoutes6().c_str(),this->getFramedRoutes6().size());
-	
-	//are there framed routes
-	if (framedroutes6[0]!='\0')
-	{
-		//get the first route
-		route=strtok(framedroutes6,";");
-		len=strlen(route);
-		if (len > 150) //this is too big!! but the length is variable
-		{
-			cerr << getTime() <<"RADIUS-PLUGIN: BACKGROUND-ACCT:  Argument for Framed Route is too long (>150 Characters).\n";
-		}
-		else
-		{
-			while (route!=NULL)
-			{		
-				//set the arrays to 0
-				memset(routestring,0,200);
-				memset(framednetmask_cidr,0,4);
-				memset(framedip,0,40);
-				memset(framedgw,0,40);
-				memset(framedmetric,0,5);
-							
-				j=0;k=0;
-				//get ip address and add it to framedip
-				while(route[j]!='/' && j<len)
-				{
-					if (route[j]!=' ')
-					{
-						framedip[k]=route[j];
-						k++;
-					}
-					j++;
-				}
-				k=0;
-				j++;
-				//get the framednetmask and add it to framednetmack_cidr
-				while(route[j]!=' ' && j<=len)
-				{
-					framednetmask_cidr[k]=route[j];
-					k++;
-					j++;
-				}
-				k=0;
-				//jump spaces
-				while(route[j]==' ' && j<=len)
-				{
-					j++;
-				}
-				//get the gateway
-				while(route[j]!='/' && j<=len)
-				{
-					if (route[j]!=' ')
-					{
-						framedgw[k]=route[j];
-						k++;
-					}
-					j++;
-				}
-				j++;
-				//find gateway netmask (this isn't used
-				//at the command route under linux)
-				while(route[j]!=' ' && j<=len)
-				{
-					j++;
-				}
-				//jump spaces
-				while(route[j]==' ' && j<=len)
-				{
-					j++;
-				}
-				k=0;
-				if (j<=len) //is there a metric (optional)
-				{
-					k=0;
-					//find the metric
-					while(route[j]!=' ' && j<=len)
-					{
-							framedmetric[k]=route[j];
-							k++;
-							j++;
-					}
-				}
-															
-				//create system call
-				strncat(routestring, "ip -6 route del ",16);
-				strncat(routestring, framedip ,40);
-				strncat(routestring, "/" ,1);
-				strncat(routestring, framednetmask_cidr, 3);
-				if (framedgw[0]!='\0')
-				{
-					strncat(routestring, " via ", 5);
-					strncat(routestring, framedgw, 40);
-				}
-				if (framedmetric[0]!='\0')
-				{
-					strncat(routestring, " metric ", 8);
-					strncat(routestring, framedmetric , 5);
-				}
-				strncat(routestring," dev ",5);
-				strcat(routestring,this->getDev().c_str());
-				strncat(routestring," proto static",13);
-				//redirect the output stderr to /dev/null
-				strncat(routestring," 2> /dev/null",13);
-				
-						
-				if (DEBUG (context->getVerbosity()))
-	    			cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Create IPv6 route string "<< routestring <<".\n";
-				
-				//system call
-				if(system(routestring)!=0) 
-				//if(1)//-> the debugg can't context system()
-				{
-					cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Route " << routestring << " could not set. Route already set or bad route string.\n";
-				}
-				else
-				{
-					if (DEBUG (context->getVerbosity()))
-	    				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Add route to system routing table.\n";
-					
-				}
-				//get the next route
-				route=strtok(NULL,";");	
-			}
-		}
-		
-	}
-	else
-	{
-		if (DEBUG (context->getVerbosity()))
-    		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  No IPv6 routes for user in AccessAcceptPacket.\n";
-	}
-	//free the char array
-	delete [] framedroutes6;
-		
+	this->callSystemRoutes(context, "del");
 }
 
 /** The method adds ths routes of the user to the system routing table.
@@ -904,304 +380,66 @@ void UserAcct::delSystemRoutes(PluginContext * context)
  */
 void UserAcct::addSystemRoutes(PluginContext * context)
 {
-	char * route;
-	char framedip[40];
-	
-	char routestring[200];
-	char framednetmask_cidr[4]; 
-	char framedgw[40];
-	char framedmetric[5];  
-	char * framedroutes, * framedroutes6;
-	int j=0,k=0,len=0;
-	
-	//copy the framed route string to an char array, it is easier to
-	//analyse
-	try{
-	  framedroutes=new char[this->getFramedRoutes().size()+1];
-	}
-	catch(...)
-	{
-	  cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND ACCT: New failed for framedroutes." << endl;
-	}
-	memset(framedroutes,0,this->getFramedRoutes().size()+1);
-	
-	// copy in a temp-string, becaue strtok deletes the delimiter, if it used anywhere
-	strncpy(framedroutes,this->getFramedRoutes().c_str(),this->getFramedRoutes().size());
+	this->callSystemRoutes(context, "add");
+}
+
+/** The method calls "ip route" for every framed route and framed IPv6 route
+ * of the user. The routes were parsed when they were set, see User::getRoutes().
+ * @param context The context of the plugin.
+ * @param action The command of "ip route", "add" or "del".
+ */
+void UserAcct::callSystemRoutes(PluginContext * context, const char * action)
+{
+	string routestring;
+	char metric[24];
+	const vector<FramedRoute> * routes;
+	int i;
 	
-	//are there framed routes
-	if (framedroutes[0]!='\0')
+	for (i=0; i < 2; i++)
 	{
-		//get the first route
-		route=strtok(framedroutes,";");
-		len=strlen(route);
-		if (len > 50) //this is to big!! but the length is variable
+		routes=(i==0) ? &this->getRoutes() : &this->getRoutes6();
+		if (routes->empty())
 		{
-			cerr << getTime() <<"RADIUS-PLUGIN: BACKGROUND-ACCT:  Argument for Framed Route is to long (>50 Characters).\n";
+			if (DEBUG (context->getVerbosity()))
+				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  No " << (i==0 ? "" : "IPv6 ") << "routes for user.\n";
+			continue;
 		}
-		else
+		for (vector<FramedRoute>::const_iterator route=routes->begin(); route!=routes->end(); route++)
 		{
-			while (route!=NULL)
-			{		
-				//set the arrays to 0
-				memset(routestring,0,100);
-				memset(framednetmask_cidr,0,3);
-				memset(framedip,0,16);
-				memset(framedgw,0,16);
-				memset(framedmetric,0,5);
-							
-				j=0;k=0;
-				//get ip address and add it to framedip
-				while(route[j]!='/' && j<len)
-				{
-					if (route[j]!=' ')
-					{
-						framedip[k]=route[j];
-						k++;
-					}
-					j++;
-				}
-				k=0;
-				j++;
-				//get the framednetmask and add it to framednetmask_cidr
-				while(route[j]!=' ' && j<=len)
-				{
-					framednetmask_cidr[k]=route[j];
-					k++;
-					j++;
-				}
-				k=0;
-				//jump spaces
-				while(route[j]==' ' && j<=len)
-				{
-					j++;
-				}
-				//get the gateway
-				while(route[j]!='/' && j<=len)
-				{
-					if (route[j]!=' ')
-					{
-						framedgw[k]=route[j];
-						k++;
-					}
-					j++;
-				}
-				j++;
-				//find gateway netmask (this isn't used
-				//at the command route under linux)
-				while(route[j]!=' ' && j<=len)
-				{
-					j++;
-				}
-				//jump spaces
-				while(route[j]==' ' && j<=len)
-				{
-					j++;
-				}
-				k=0;
-				if (j<=len) //is there a metric (optional)
-				{
-					k=0;
-					//find the metric
-					while(route[j]!=' ' && j<=len)
-					{
-							framedmetric[k]=route[j];
-							k++;
-							j++;
-					}
-				}
-															
-														
-				//create system call
-				strncat(routestring, "ip route add ",13);
-				strncat(routestring, framedip ,16);
-				strncat(routestring, "/" ,1);
-				strncat(routestring, framednetmask_cidr, 2);
-				if (framedgw[0]!='\0')
-				{
-					strncat(routestring, " via ", 5);
-					strncat(routestring, framedgw, 16);
-				}
-				if (framedmetric[0]!='\0')
-				{
-					strncat(routestring, " metric ", 8);
-					strncat(routestring, framedmetric , 5);
-				}
-				strncat(routestring," dev ",5);
-				strcat(routestring,this->getDev().c_str());
-				strncat(routestring," proto static",13);
-				//redirect the output stderr to /dev/null
-				strncat(routestring," 2> /dev/null",13);
-				
-						
-				if (DEBUG (context->getVerbosity()))
-	    			cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Create route string "<< routestring << ".\n";
-				
-				//system call route
-				if(system(routestring)!=0) 
-				//if(1)//-> the debugg can't context system()
-				{
-					cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Route " << routestring << " could not set. Route already set or bad route string.\n";
-				}
-				else
-				{
-					if (DEBUG (context->getVerbosity()))
-	    				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Add route to system routing table.\n";
-												
-				}
-				//get the next route
-				route=strtok(NULL,";");	
+			//create system call
+			routestring=(route->family==AF_INET6) ? "ip -6 route " : "ip route ";
+			routestring+=action;
+			routestring+=" "+route->getPrefix();
+			snprintf(metric,sizeof(metric),"/%d",route->prefixlen);
+			routestring+=metric;
+			if (route->hasgateway)
+			{
+				routestring+=" via "+route->getGateway();
 			}
-		}
-	}
-	else
-	{
-		if (DEBUG (context->getVerbosity()))
-    		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  No routes for user.\n";
-	}
-	//free the char array
-	delete [] framedroutes;
-	
-	//copy the framed route string to an char array, it is easier to
-	//analyse
-	framedroutes6=new char[this->getFramedRoutes6().size()+1];
-	memset(framedroutes6,0,this->getFramedRoutes6().size()+1);
-	
-	// copy in a temp-string, becaue strtok deletes the delimiter, if it used anywhere
-	strncpy(framedroutes6,this->getFramedRoutes6().c_str(),this->getFramedRoutes6().size());
-	
-	//are there framed routes
-	if (framedroutes6[0]!='\0')
-	{
-		//get the first route
-		route=strtok(framedroutes6,";");
-		len=strlen(route);
-		if (len > 150) //this is to big!! but the length is variable
-		{
-			cerr << getTime() <<"RADIUS-PLUGIN: BACKGROUND-ACCT:  Argument for Framed Route is to long (>150 Characters).\n";
-		}
-		else
-		{
-			while (route!=NULL)
-			{		
-				//set the arrays to 0
-				memset(routestring,0,200);
-				memset(framednetmask_cidr,0,4);
-				memset(framedip,0,40);
-				memset(framedgw,0,40);
-				memset(framedmetric,0,5);
-							
-				j=0;k=0;
-				//get ip address and add it to framedip
-				while(route[j]!='/' && j<len)
-				{
-					if (route[j]!=' ')
-					{
-						framedip[k]=route[j];
-						k++;
-					}
-					j++;
-				}
-				k=0;
-				j++;
-				//get the framednetmask and add it to framednetmask_cidr
-				while(route[j]!=' ' && j<=len)
-				{
-					framednetmask_cidr[k]=route[j];
-					k++;
-					j++;
-				}
-				k=0;
-				//jump spaces
-				while(route[j]==' ' && j<=len)
-				{
-					j++;
-				}
-				//get the gateway
-				while(route[j]!='/' && j<=len)
-				{
-					if (route[j]!=' ')
-					{
-						framedgw[k]=route[j];
-						k++;
-					}
-					j++;
-				}
-				j++;
-				//find gateway netmask (this isn't used
-				//at the command route under linux)
-				while(route[j]!=' ' && j<=len)
-				{
-					j++;
-				}
-				//jump spaces
-				while(route[j]==' ' && j<=len)
-				{
-					j++;
-				}
-				k=0;
-				if (j<=len) //is there a metric (optional)
-				{
-					k=0;
-					//find the metric
-					while(route[j]!=' ' && j<=len)
-					{
-							framedmetric[k]=route[j];
-							k++;
-							j++;
-					}
-				}
-															
-														
-				//create system call
-				strncat(routestring, "ip -6 route add ",21);
-				strncat(routestring, framedip ,40);
-				strncat(routestring, "/" ,1);
-				strncat(routestring, framednetmask_cidr, 3);
-				if (framedgw[0]!='\0')
-				{
-					strncat(routestring, " via ", 5);
-					strncat(routestring, framedgw, 40);
-				}
-				if (framedmetric[0]!='\0')
-				{
-					strncat(routestring, " metric ", 8);
-					strncat(routestring, framedmetric , 5);
-				}
-				strncat(routestring," dev ",5);
-				strcat(routestring,this->getDev().c_str());
-				strncat(routestring," proto static",13);
-				//redirect the output stderr to /dev/null
-				strncat(routestring," 2> /dev/null",13);
-				
-						
+			if (route->metric >= 0)
+			{
+				snprintf(metric,sizeof(metric)," metric %d",route->metric);
+				routestring+=metric;
+			}
+			routestring+=" dev "+this->getDev()+" proto static";
+			//redirect the output stderr to /dev/null
+			routestring+=" 2> /dev/null";
+			
+			if (DEBUG (context->getVerbosity()))
+				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Create route string "<< routestring <<".\n";
+			
+			//system call
+			if(system(routestring.c_str())!=0) 
+			{
+				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Route " << routestring << " could not " << action << ". Route already set or bad route string.\n";
+			}
+			else
+			{
 				if (DEBUG (context->getVerbosity()))
-				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Create IPv6 route string "<< routestring << " dev " << this->getDev() << ".\n";
-				
-				//system call route
-				if(system(routestring)!=0) 
-				//if(1)//-> the debugg can't context system()
-				{
-					cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Route " << routestring << " could not set. Route already set or bad route string.\n";
-				}
-				else
-				{
-					if (DEBUG (context->getVerbosity()))
-	    				cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Add route to system routing table.\n";
-												
-				}
-				//get the next route
-				route=strtok(NULL,";");	
+					cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  Route " << action << " in system routing table.\n";
 			}
 		}
 	}
-	else
-	{
-		if (DEBUG (context->getVerbosity()))
-    		cerr << getTime() << "RADIUS-PLUGIN: BACKGROUND-ACCT:  No IPv6 routes for user.\n";
-	}
-	//free the char array
-	delete [] framedroutes6;
-	
 }
 
 
@@ -44,6 +44,11 @@ private:
 	uint32_t bytesout;		/**< The sent bytes.*/
 	time_t nextupdate;		/**< The next update time.*/
 	time_t starttime;		/**< The start time of the connection.*/
+	string attributes;		/**< The serialized attributes of the accounting packets, they are built once 
+	for the session. The Acct-Status-Type and the counters at the end are patched for every packet.*/
+	
+	int buildPacket(PluginContext *, RadiusPacket *, uint32_t);
+	void callSystemRoutes(PluginContext *, const char *);
 	
 public:
 	
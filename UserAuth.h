@@ -27,8 +27,9 @@
 #include "RadiusClass/RadiusAttribute.h"
 #include "RadiusClass/RadiusVendorSpecificAttribute.h"
 #include "RadiusClass/error.h"
-#include "RadiusClass/vsa.h"
+#include "RadiusClass/RadiusDictionary.h"
 #include "User.h"
+#include "AccessReply.h"
 #include "PluginContext.h"
 #include "radiusplugin.h"
 #include <string.h>
@@ -45,6 +46,7 @@ class UserAuth : public User
 {
 private:
 	string password;				/**<The password of the user.*/
+	AccessReply reply;				/**<The attributes of the Access-Accept.*/
 
 public:
   	  	
@@ -57,6 +59,7 @@ public:
   	
   	int sendAcceptRequestPacket(PluginContext *);
   	void parseResponsePacket(RadiusPacket *,  PluginContext *);
+  	AccessReply * getReply(void);
 	int createCcdFile(PluginContext *);
 	string valueToString(RadiusVendorSpecificAttribute *);
 	
@@ -0,0 +1,246 @@
+/*
+ *  radiusplugin -- An OpenVPN plugin for do radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+ 
+#include "UserMap.h"
+#include "UserPlugin.h"
+
+/** The constructor of an empty slot.*/
+UserMapSlot::UserMapSlot(void)
+{
+	this->hash=0;
+	this->user=NULL;
+}
+
+/** The constructor allocates USERMAP_SHARD_SIZE empty slots.*/
+UserMapShard::UserMapShard(void)
+{
+	pthread_rwlock_init(&this->lock, NULL);
+	this->slots=new UserMapSlot[USERMAP_SHARD_SIZE];
+	this->mask=USERMAP_SHARD_SIZE-1;
+	this->count=0;
+}
+
+/** The destructor frees the slots, the users must be released before.*/
+UserMapShard::~UserMapShard(void)
+{
+	delete [] this->slots;
+	pthread_rwlock_destroy(&this->lock);
+}
+
+/** The method searches the slot of a key, the caller holds the lock.
+ * @param hash The hash of the key.
+ * @param key The key.
+ * @return The index of the slot with the key or of the empty slot where the probing stopped.
+ */
+unsigned int UserMapShard::lookup(unsigned int hash, const string &key)
+{
+	unsigned int i=hash & this->mask;
+	
+	while (this->slots[i].user!=NULL)
+	{
+		if (this->slots[i].hash==hash && this->slots[i].key==key)
+		{
+			break;
+		}
+		i=(i+1) & this->mask;
+	}
+	return i;
+}
+
+/** The method doubles the number of slots and inserts the users again, 
+ * the caller holds the lock for writing.*/
+void UserMapShard::grow(void)
+{
+	UserMapSlot		*old=this->slots;
+	unsigned int	oldsize=this->mask+1, i, j;
+	
+	this->slots=new UserMapSlot[oldsize*2];
+	this->mask=oldsize*2-1;
+	for (i=0; i < oldsize; i++)
+	{
+		if (old[i].user!=NULL)
+		{
+			j=this->lookup(old[i].hash, old[i].key);
+			this->slots[j].hash=old[i].hash;
+			this->slots[j].key.swap(old[i].key);
+			this->slots[j].user=old[i].user;
+		}
+	}
+	delete [] old;
+}
+
+
+/** The constructor of an empty map.*/
+UserMap::UserMap(void)
+{
+}
+
+/** The destructor releases all users of the map.*/
+UserMap::~UserMap(void)
+{
+	this->clear();
+}
+
+/** The method calculates the hash of a key (FNV-1a with a final mix), the upper bits
+ * select the shard, the lower bits the slot.
+ * @param key The key.
+ * @return The hash.
+ */
+unsigned int UserMap::hashKey(const string &key)
+{
+	unsigned int h=2166136261u;
+	
+	for (string::size_type i=0; i < key.length(); i++)
+	{
+		h^=(unsigned char) key[i];
+		h*=16777619u;
+	}
+	h^=h >> 15;
+	h*=0x2c1b3c6du;
+	h^=h >> 12;
+	return h;
+}
+
+/** The method inserts a user, the map takes a reference to the user.
+ * @param key The key of the user.
+ * @param user The user.
+ * @return False if there is already a user with the key.
+ */
+bool UserMap::insert(const string &key, UserPlugin *user)
+{
+	unsigned int	hash=hashKey(key);
+	UserMapShard	*shard=&this->shards[hash >> (32-USERMAP_SHARD_BITS)];
+	unsigned int	i;
+	bool			inserted=false;
+	
+	pthread_rwlock_wrlock(&shard->lock);
+	i=shard->lookup(hash, key);
+	if (shard->slots[i].user==NULL)
+	{
+		user->retain();
+		shard->slots[i].hash=hash;
+		shard->slots[i].key=key;
+		shard->slots[i].user=user;
+		shard->count++;
+		//the load factor is kept under 3/4, so the probing is short
+		if (shard->count*4 > (shard->mask+1)*3)
+		{
+			shard->grow();
+		}
+		inserted=true;
+	}
+	pthread_rwlock_unlock(&shard->lock);
+	return inserted;
+}
+
+/** The method finds a user, the caller gets an own reference
+ * and must call UserPlugin::release() if it doesn't need the user any more.
+ * @param key The key of the user.
+ * @return The user or NULL if there is no user with the key.
+ */
+UserPlugin * UserMap::find(const string &key)
+{
+	unsigned int	hash=hashKey(key);
+	UserMapShard	*shard=&this->shards[hash >> (32-USERMAP_SHARD_BITS)];
+	UserPlugin		*user;
+	
+	pthread_rwlock_rdlock(&shard->lock);
+	user=shard->slots[shard->lookup(hash, key)].user;
+	if (user!=NULL)
+	{
+		user->retain();
+	}
+	pthread_rwlock_unlock(&shard->lock);
+	return user;
+}
+
+/** The method deletes a user from the map and releases the reference of the map.
+ * The slots after the deleted slot are shifted back, so there are no tombstones.
+ * @param key The key of the user.
+ * @return False if there is no user with the key.
+ */
+bool UserMap::erase(const string &key)
+{
+	unsigned int	hash=hashKey(key);
+	UserMapShard	*shard=&this->shards[hash >> (32-USERMAP_SHARD_BITS)];
+	UserPlugin		*user;
+	unsigned int	i, j, home;
+	
+	pthread_rwlock_wrlock(&shard->lock);
+	i=shard->lookup(hash, key);
+	user=shard->slots[i].user;
+	if (user!=NULL)
+	{
+		j=i;
+		for (;;)
+		{
+			j=(j+1) & shard->mask;
+			if (shard->slots[j].user==NULL)
+			{
+				break;
+			}
+			//the slot j can be moved to i, if i lies between its home slot and j
+			home=shard->slots[j].hash & shard->mask;
+			if (((j-home) & shard->mask) >= ((j-i) & shard->mask))
+			{
+				shard->slots[i].hash=shard->slots[j].hash;
+				shard->slots[i].key.swap(shard->slots[j].key);
+				shard->slots[i].user=shard->slots[j].user;
+				i=j;
+			}
+		}
+		shard->slots[i].key.clear();
+		shard->slots[i].user=NULL;
+		shard->count--;
+	}
+	pthread_rwlock_unlock(&shard->lock);
+	
+	//the user is deleted outside of the lock, if it was the last reference
+	if (user!=NULL)
+	{
+		user->release();
+		return true;
+	}
+	return false;
+}
+
+/** The method deletes all users from the map and releases the references of the map.*/
+void UserMap::clear(void)
+{
+	unsigned int i, j;
+	
+	for (i=0; i < USERMAP_SHARDS; i++)
+	{
+		pthread_rwlock_wrlock(&this->shards[i].lock);
+		for (j=0; j <= this->shards[i].mask; j++)
+		{
+			if (this->shards[i].slots[j].user!=NULL)
+			{
+				this->shards[i].slots[j].user->release();
+				this->shards[i].slots[j].user=NULL;
+				this->shards[i].slots[j].key.clear();
+			}
+		}
+		this->shards[i].count=0;
+		pthread_rwlock_unlock(&this->shards[i].lock);
+	}
+}
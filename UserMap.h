@@ -0,0 +1,97 @@
+/*
+ *  radiusplugin -- An OpenVPN plugin for do radius authentication 
+ *					and accounting.
+ * 
+ *  Copyright (C) 2005 EWE TEL GmbH/Ralf Luebben <ralfluebben@gmx.de>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+ 
+ 
+ 
+#ifndef _USERMAP_H_
+#define _USERMAP_H_
+
+#include <pthread.h>
+#include <string>
+
+using std::string;
+
+class UserPlugin;
+
+/** The number of bits of the hash which select the shard.*/
+#define USERMAP_SHARD_BITS 6
+/** The number of shards of the user map.*/
+#define USERMAP_SHARDS (1 << USERMAP_SHARD_BITS)
+/** The number of slots of a new shard, a power of 2.*/
+#define USERMAP_SHARD_SIZE 16
+
+/** A slot of a shard, the slot is empty if user is NULL.*/
+class UserMapSlot
+{
+public:
+	unsigned int	hash;		/**<The hash of the key.*/
+	string			key;		/**<The key of the user.*/
+	UserPlugin		*user;		/**<The user.*/
+	
+	UserMapSlot(void);
+};
+
+/** A shard of the user map, a hash table with open addressing (linear probing)
+ * and an own reader/writer lock.*/
+class UserMapShard
+{
+public:
+	pthread_rwlock_t	lock;		/**<The lock of the shard, find() takes it for reading.*/
+	UserMapSlot			*slots;		/**<The slots.*/
+	unsigned int		mask;		/**<The number of slots minus 1.*/
+	unsigned int		count;		/**<The number of users in the shard.*/
+	
+	UserMapShard(void);
+	~UserMapShard(void);
+	
+	unsigned int lookup(unsigned int, const string &);
+	void grow(void);
+};
+
+/** The class is the map of the users of the foreground process which are authenticated, 
+ * the key is the key of the user (commonname,ip:port). It is used by OpenVPN's thread and
+ * the threads of the plugin at the same time. The keys are spread with the hash over 
+ * USERMAP_SHARDS shards with an own reader/writer lock, so lookups don't wait for each other
+ * and a change locks only one shard.
+ * The map holds a reference to every user (UserPlugin::retain()), find() returns the user with 
+ * an additional reference, so a user which is deleted from the map by another thread
+ * stays valid until the finder calls UserPlugin::release().*/
+class UserMap
+{
+private:
+	UserMapShard	shards[USERMAP_SHARDS];	/**<The shards.*/
+	
+	UserMap(const UserMap &);
+	UserMap & operator=(const UserMap &);
+	
+	static unsigned int hashKey(const string &);
+	
+public:
+	UserMap(void);
+	~UserMap(void);
+	
+	bool insert(const string &, UserPlugin *);
+	UserPlugin * find(const string &);
+	bool erase(const string &);
+	void clear(void);
+};
+
+#endif //_USERMAP_H_
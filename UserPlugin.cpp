@@ -23,13 +23,16 @@
 
 /**The constructor sets the sessionid and sends the portnumber to the
  * constructor of the class User, where the portnumber is set. The flags 
- * authenticated and accounted are set to false.*/
+ * authenticated and accounted are set to false. The creator holds the
+ * first reference.*/
 UserPlugin::UserPlugin() : User()
 {
 	this->accounted=false;
 	this->authenticated=false;
         this->authcontrolfile="";
         this->clientconnectdeferfile="";
+	this->completion=NULL;
+	this->refs=1;
 }
 
 /**The destructor, nothing happens here.*/
@@ -53,6 +56,7 @@ UserPlugin & UserPlugin::operator=(const UserPlugin &u)
 		this->untrustedport=u.untrustedport;
                 this->authcontrolfile=u.authcontrolfile;
                 this->clientconnectdeferfile=u.clientconnectdeferfile;
+		this->completion=NULL;
 	}
 	return *this;
 	
@@ -81,6 +85,8 @@ UserPlugin::UserPlugin(const UserPlugin &u) : User(u)
 	this->untrustedport=u.untrustedport;
         this->authcontrolfile=u.authcontrolfile;
         this->clientconnectdeferfile=u.clientconnectdeferfile;
+	this->completion=NULL;
+	this->refs=1;
 }
 
 /**The getter method of the password.
@@ -162,4 +168,51 @@ void UserPlugin::setClientConnectDeferFile(string file)
   clientconnectdeferfile=file;
 }
 
+/** The getter method for the completion slot.
+ * @return The completion slot or NULL if OpenVPN doesn't wait for the request.
+ */
+Completion * UserPlugin::getCompletion(void)
+{
+	return this->completion;
+}
 
+/** The setter method for the completion slot.
+ * @param c The completion slot or NULL.
+ */
+void UserPlugin::setCompletion(Completion * c)
+{
+	this->completion=c;
+}
+
+/** The method passes the result of the request to the waiting OpenVPN thread.
+ * The slot is removed from the user, because the waiting thread frees it.
+ * Nothing happens if OpenVPN doesn't wait for the request.
+ * @param result The result, OPENVPN_PLUGIN_FUNC_SUCCESS or OPENVPN_PLUGIN_FUNC_ERROR.
+ */
+void UserPlugin::complete(int result)
+{
+	Completion * c=this->completion;
+	
+	if (c!=NULL)
+	{
+		this->completion=NULL;
+		c->complete(result);
+	}
+}
+
+/** The method adds a reference to the user, e.g. the user map
+ * or a thread which found the user in the map.*/
+void UserPlugin::retain(void)
+{
+	__atomic_add_fetch(&this->refs, 1, __ATOMIC_RELAXED);
+}
+
+/** The method drops a reference, the user is deleted with the last one.
+ * The user must not be used after the call.*/
+void UserPlugin::release(void)
+{
+	if (__atomic_sub_fetch(&this->refs, 1, __ATOMIC_ACQ_REL)==0)
+	{
+		delete this;
+	}
+}
@@ -22,6 +22,7 @@
 #ifndef _USERPLUGIN_H_
 #define _USERPLUGIN_H_
 #include "User.h"
+#include "Completion.h"
 #include <time.h>
 #include <string.h>
 #include <string>
@@ -40,6 +41,8 @@ private:
         string clientconnectdeferfile; /**<The client-connect defer file of the user.*/
 	bool authenticated; 	/**<Indicates if a user is authenticated.*/
 	bool accounted;		/**<Indicates if a user is accounted.*/
+	Completion * completion;	/**<The completion slot if OpenVPN waits for the request, else NULL.*/
+	int refs;			/**<The number of references, the user is deleted by release() if it is 0.*/
 	
 
 public:
@@ -70,6 +73,13 @@ public:
 	bool isAccounted(void);
 	void setAccounted(bool);
 	
+	Completion * getCompletion(void);
+	void setCompletion(Completion *);
+	void complete(int);
+	
+	void retain(void);
+	void release(void);
+	
 };
 
 #endif //_USERPLUGIN_H_
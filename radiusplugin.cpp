@@ -23,8 +23,6 @@
 
 #include "radiusplugin.h"
 #include <time.h>
-#define NEED_LIBGCRYPT_VERSION "1.2.0"
-GCRY_THREAD_OPTION_PTHREAD_IMPL;
 
 //define extern "C", so the c++ compiler generate a shared library
 //which is compatible with c programms
@@ -61,6 +59,8 @@ extern "C"
         AccountingProcess   	Acct;		/**<The accounting background process object.*/
         AuthenticationProcess 	Auth; 		/**<The authentication background process object.*/
         PluginContext *context=NULL; 			/**<The context for this functions.*/
+        AuthWorker				*worker;	/**<An authentication worker.*/
+        int						i;
 
 
         
@@ -71,6 +71,9 @@ extern "C"
         //There must be one param, the name of the plugin file
         const int base_parms = 1;
 
+	//initialize libgcrypt once, before the background processes are forked
+	RadiusCrypto::init();
+
 	//Create the context.
 	try{
 	  context=new PluginContext;
@@ -150,6 +153,8 @@ extern "C"
         }
 
 
+        context->initNasPorts ( context->conf.getFirstNasPort(), context->conf.getLastNasPort() );
+
         // Intercept the --auth-user-pass-verify, --client-connect and --client-disconnect callback.
         if (context->conf.getAccountingOnly()==false)
         {
@@ -161,13 +166,7 @@ extern "C"
         }
         // Make a socket for foreground and background processes
         // to communicate.
-        //Authentication process:
-        if ( socketpair ( PF_UNIX, SOCK_DGRAM, 0, fd_auth ) == -1 )
-        {
-            cerr << getTime() << "RADIUS-PLUGIN: socketpair call failed for authentication process\n";
-            goto error;
-        }
-        //Accounting process:
+        //Accounting process, the sockets of the authentication processes are made for every worker:
         if ( socketpair ( PF_UNIX, SOCK_DGRAM, 0, fd_acct ) == -1 )
         {
             cerr << getTime() << "RADIUS-PLUGIN: socketpair call failed for accounting process\n";
@@ -181,66 +180,82 @@ extern "C"
         //  even after the foreground process drops its privileges.
 
 
-        // 	Fork the authentication process
-        pid = fork ();
-        if ( pid )
+        // 	Fork the authentication processes, every worker thread gets an own
+        //	background process, so a slow radius server blocks only one worker
+        for ( i=0; i < context->conf.getAuthWorkers(); i++ )
         {
-            // Foreground Process (Parent)
-            int status;
+            //Authentication process of the worker:
+            if ( socketpair ( PF_UNIX, SOCK_DGRAM, 0, fd_auth ) == -1 )
+            {
+                cerr << getTime() << "RADIUS-PLUGIN: socketpair call failed for authentication process\n";
+                goto error;
+            }
+            
+            pid = fork ();
+            if ( pid )
+            {
+                // Foreground Process (Parent)
+                int status;
 
-            //save the process id
-            context->setAuthPid ( pid );
+                //save the process id
+                worker=new AuthWorker ( context );
+                worker->pid=pid;
+                context->authworkers.push_back ( worker );
 
-            // close our copy of child's socket
-            close ( fd_auth[1] );
+                // close our copy of child's socket
+                close ( fd_auth[1] );
 
-            /* don't let future subprocesses inherit child socket */
-            if ( fcntl ( fd_auth[0], F_SETFD, FD_CLOEXEC ) < 0 )
-                cerr << getTime() << "RADIUS-PLUGIN: Set FD_CLOEXEC flag on socket file descriptor failed\n";
+                /* don't let future subprocesses inherit child socket */
+                if ( fcntl ( fd_auth[0], F_SETFD, FD_CLOEXEC ) < 0 )
+                    cerr << getTime() << "RADIUS-PLUGIN: Set FD_CLOEXEC flag on socket file descriptor failed\n";
 
-            if ( DEBUG ( context->getVerbosity() ) )
-                cerr << getTime() << "RADIUS-PLUGIN: Start BACKGROUND Process for authentication with PID " << context->getAuthPid() << ".\n";
+                if ( DEBUG ( context->getVerbosity() ) )
+                    cerr << getTime() << "RADIUS-PLUGIN: Start BACKGROUND Process for authentication with PID " << worker->pid << ".\n";
 
-            //save the socket number in the context
-            context->authsocketbackgr.setSocket ( fd_auth[0] );
+                //save the socket number in the worker
+                worker->socket.setSocket ( fd_auth[0] );
 
-            //wait for background child process to initialize */
-            status = context->authsocketbackgr.recvInt();
+                //wait for background child process to initialize */
+                status = worker->socket.recvInt();
 
-            if ( status != RESPONSE_INIT_SUCCEEDED )
-            {
-                //set the socket to -1 if the initialization failed
-                context->authsocketbackgr.setSocket ( -1 );
+                if ( status != RESPONSE_INIT_SUCCEEDED )
+                {
+                    //set the socket to -1 if the initialization failed
+                    worker->socket.setSocket ( -1 );
+                }
+
+                if ( DEBUG ( context->getVerbosity() ) )
+                    cerr << getTime() << "RADIUS-PLUGIN: Start AUTH-RADIUS-PLUGIN\n";
             }
+            else
+            {
 
-            if ( DEBUG ( context->getVerbosity() ) )
-                cerr << getTime() << "RADIUS-PLUGIN: Start AUTH-RADIUS-PLUGIN\n";
-        }
-        else
-        {
+                //Background Process
 
-            //Background Process
+                // close all parent fds except our socket back to parent
+                close_fds_except ( fd_auth[1] );
 
-            // close all parent fds except our socket back to parent
-            close_fds_except ( fd_auth[1] );
+                // Ignore most signals (the parent will receive them)
+                set_signals ();
 
-            // Ignore most signals (the parent will receive them)
-            set_signals ();
+                //save the socket number in the context
+                context->authsocketforegr.setSocket ( fd_auth[1] );
 
-            //save the socket number in the context
-            context->authsocketforegr.setSocket ( fd_auth[1] );
+                //the hedging budget and the in-flight limits are shared by the authentication processes
+                context->radiusconf.shareAuthLimits ( context->conf.getAuthWorkers() );
 
-            //start the backgroung event loop for accounting
-            Auth.Authentication ( context );
+                //start the backgroung event loop for accounting
+                Auth.Authentication ( context );
 
-            //close the socket
-            close ( fd_auth[1] );
+                //close the socket
+                close ( fd_auth[1] );
 
-            //free the context of the background process
-            delete context;
+                //free the context of the background process
+                delete context;
 
-            exit ( 0 );
-            return 0; // NOTREACHED
+                exit ( 0 );
+                return 0; // NOTREACHED
+            }
         }
 
         // 	Fork the accounting process
@@ -359,30 +374,29 @@ error:
         if (context->getStartThread())
         {
 
-            pthread_cond_init (context->getCondSend(), NULL);
-            pthread_mutex_init (context->getMutexSend(), NULL);
-            pthread_cond_init (context->getCondRecv(), NULL);
-            pthread_mutex_init (context->getMutexRecv(), NULL);
-            pthread_cond_init (context->getAcctCondSend(), NULL);
-            pthread_mutex_init (context->getAcctMutexSend(), NULL);
-            pthread_cond_init (context->getAcctCondRecv(), NULL);
-            pthread_mutex_init (context->getAcctMutexRecv(), NULL);
-
             if (pthread_create(context->getAcctThread(), NULL, &client_connect, (void *) context) != 0)
             {
                 cerr << getTime() << "RADIUS-PLUGIN: client_connect thread creation failed.\n";
                 return OPENVPN_PLUGIN_FUNC_ERROR;
                 //goto error;
             }
-            if (context->conf.getAccountingOnly()==false && pthread_create(context->getThread(), NULL, &auth_user_pass_verify, (void *) context) != 0)
+            //start a thread for every authentication worker with a background process
+            for (unsigned int i=0; context->conf.getAccountingOnly()==false && i < context->authworkers.size(); i++)
             {
-                cerr << getTime() << "RADIUS-PLUGIN: auth_user_pass_verify thread creation failed.\n";
-                return OPENVPN_PLUGIN_FUNC_ERROR;
-                //goto error;
+                AuthWorker * worker=context->authworkers[i];
+                if (worker->socket.getSocket() < 0)
+                {
+                    continue;
+                }
+                if (pthread_create(&worker->thread, NULL, &auth_user_pass_verify, (void *) worker) != 0)
+                {
+                    cerr << getTime() << "RADIUS-PLUGIN: auth_user_pass_verify thread creation failed.\n";
+                    return OPENVPN_PLUGIN_FUNC_ERROR;
+                    //goto error;
+                }
+                worker->started=true;
             }
-            pthread_mutex_lock(context->getMutexRecv());
             context->setStartThread(false);
-            pthread_mutex_unlock(context->getMutexRecv());
         }
 
         UserPlugin 	*newuser=NULL; 	/**< A context for an new user.*/
@@ -393,7 +407,7 @@ error:
 
 
         ///////////// OPENVPN_PLUGIN_AUTH_USER_PASS_VERIFY
-        if ( type == OPENVPN_PLUGIN_AUTH_USER_PASS_VERIFY && ( context->authsocketbackgr.getSocket() ) >= 0 )
+        if ( type == OPENVPN_PLUGIN_AUTH_USER_PASS_VERIFY && context->hasAuthWorkers() )
         {
 
             if ( DEBUG ( context->getVerbosity() ) )
@@ -407,24 +421,27 @@ error:
                 get_user_env(context,type,envp, newuser);
                 if (newuser->getAuthControlFile().length() > 0 && context->conf.getUseAuthControlFile())
                 {
-                  pthread_mutex_lock(context->getMutexSend());
-                  context->addNewUser(newuser);
-                  pthread_cond_signal( context->getCondSend( ));
-                  pthread_mutex_unlock (context->getMutexSend());
+                  if (!context->addNewUser(newuser))
+                  {
+                    cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND: The authentication queue is full.\n";
+                    delete newuser;
+                    return OPENVPN_PLUGIN_FUNC_ERROR;
+                  }
                   return OPENVPN_PLUGIN_FUNC_DEFERRED;
                 }
                 else
                 {
-                  pthread_mutex_lock(context->getMutexRecv());
-                  pthread_mutex_lock(context->getMutexSend());
-                  context->addNewUser(newuser);
-                  pthread_cond_signal( context->getCondSend( ));
-                  pthread_mutex_unlock (context->getMutexSend());
-				  
-				  pthread_cond_wait( context->getCondRecv(), context->getMutexRecv());
-				  pthread_mutex_unlock (context->getMutexRecv());
-                                  
-				  return context->getResult();
+                  //the worker passes the result in the completion slot of the request
+                  Completion completion;
+                  newuser->setCompletion(&completion);
+                  if (!context->addNewUser(newuser))
+                  {
+                    cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND: The authentication queue is full.\n";
+                    delete newuser;
+                    return OPENVPN_PLUGIN_FUNC_ERROR;
+                  }
+                  
+                  return completion.wait();
                 }
             }
             catch ( Exception &e )
@@ -459,23 +476,27 @@ error:
 
                 if (tmpuser->getClientConnectDeferFile().length() > 0 && context->conf.getUseClientConnectDeferFile())
                 {
-                    pthread_mutex_lock(context->getAcctMutexSend());
-                    context->addNewAcctUser(tmpuser);
-                    pthread_cond_signal( context->getAcctCondSend( ));
-                    pthread_mutex_unlock (context->getAcctMutexSend());
+                    if (!context->addNewAcctUser(tmpuser))
+                    {
+                        cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND: The accounting queue is full.\n";
+                        delete tmpuser;
+                        return OPENVPN_PLUGIN_FUNC_ERROR;
+                    }
                     return OPENVPN_PLUGIN_FUNC_DEFERRED; 
                 }
                 else
                 {
-                    pthread_mutex_lock(context->getAcctMutexRecv());
-                    pthread_mutex_lock(context->getAcctMutexSend());
-                    context->addNewAcctUser(tmpuser);
-                    pthread_cond_signal( context->getAcctCondSend( ));
-                    pthread_mutex_unlock (context->getAcctMutexSend());
-                    pthread_cond_wait( context->getAcctCondRecv(), context->getAcctMutexRecv());
-                    pthread_mutex_unlock (context->getAcctMutexRecv());
-
-                    return context->getResult();
+                    //the thread passes the result in the completion slot of the request
+                    Completion completion;
+                    tmpuser->setCompletion(&completion);
+                    if (!context->addNewAcctUser(tmpuser))
+                    {
+                        cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND: The accounting queue is full.\n";
+                        delete tmpuser;
+                        return OPENVPN_PLUGIN_FUNC_ERROR;
+                    }
+
+                    return completion.wait();
                 }
             }
             catch ( Exception &e )
@@ -504,6 +525,7 @@ error:
             {
                 cerr << getTime() << "\n\nRADIUS-PLUGIN: FOREGROUND: OPENVPN_PLUGIN_CLIENT_DISCONNECT is called.\n";
             }
+            newuser=NULL;
             try
             {
                 tmpuser=new UserPlugin();
@@ -542,8 +564,10 @@ error:
                     //free the nasport
                     context->delNasPort ( newuser->getPortnumber() );
 
-                    //delete user from context
+                    //delete user from context, the user is freed with the last reference
                     context->delUser ( newuser->getKey() );
+                    newuser->release();
+                    newuser=NULL;
                     return OPENVPN_PLUGIN_FUNC_SUCCESS;
                 }
                 else
@@ -564,7 +588,12 @@ error:
             {
                 cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND:" << "Unknown Exception!\n";
             }
-
+            
+            //release the reference of findUser(), if the accounting failed
+            if ( newuser!=NULL )
+            {
+                newuser->release();
+            }
         }
 
         return OPENVPN_PLUGIN_FUNC_ERROR;
@@ -585,15 +614,20 @@ error:
         if ( DEBUG ( context->getVerbosity() ) )
             cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND: close\n";
 
-        if ( context->authsocketbackgr.getSocket() >= 0 )
+        for ( unsigned int i=0; i < context->authworkers.size(); i++ )
         {
+            AuthWorker * worker=context->authworkers[i];
+            if ( worker->socket.getSocket() < 0 )
+            {
+                continue;
+            }
             if ( DEBUG ( context->getVerbosity() ) )
                 cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND: close auth background process\n";
 
             //tell background process to exit
             try
             {
-                context->authsocketbackgr.send ( COMMAND_EXIT );
+                worker->socket.send ( COMMAND_EXIT );
             }
             catch ( Exception &e )
             {
@@ -605,8 +639,8 @@ error:
             }
 
             // wait for background process to exit
-            if ( context->getAuthPid() > 0 )
-                waitpid ( context->getAuthPid(), NULL, 0 );
+            if ( worker->pid > 0 )
+                waitpid ( worker->pid, NULL, 0 );
 
         }
 
@@ -639,28 +673,17 @@ error:
             if ( DEBUG ( context->getVerbosity() ) )
                 cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND: Stop auth thread .\n";
             
-	    //stop the threads
-            pthread_mutex_lock(context->getMutexSend());
+	    //stop the threads, the flag wakes them
             context->setStopThread(true);
-            pthread_cond_signal( context->getCondSend( ));
-            pthread_mutex_unlock(context->getMutexSend());
-            pthread_mutex_lock(context->getAcctMutexSend());
-            pthread_cond_signal( context->getAcctCondSend( ));
-            pthread_mutex_unlock(context->getAcctMutexSend());
 	    
             
 	    //wait for the thread to exit
-            if (context->conf.getAccountingOnly()==false)
-                pthread_join(*context->getThread(),NULL);
+            for (unsigned int i=0; i < context->authworkers.size(); i++)
+            {
+                if (context->authworkers[i]->started)
+                    pthread_join(context->authworkers[i]->thread,NULL);
+            }
             pthread_join(*context->getAcctThread(),NULL);
-	    pthread_cond_destroy(context->getCondSend( ));
-	    pthread_cond_destroy(context->getCondRecv( ));
-	    pthread_mutex_destroy(context->getMutexSend());
-	    pthread_mutex_destroy(context->getMutexRecv());
-            pthread_cond_destroy(context->getAcctCondSend( ));
-	    pthread_cond_destroy(context->getAcctCondRecv( ));
-	    pthread_mutex_destroy(context->getAcctMutexSend());
-	    pthread_mutex_destroy(context->getAcctMutexRecv());
         }
         else
         {
@@ -748,16 +771,32 @@ void close_fds_except ( int keep )
     }
 }
 
+/** The signal handler for SIGHUP in the background processes.
+ * The cached addresses of the radius servers expire, the names are
+ * resolved again in the background when the next packet is sent.
+ * @param sig The signal number.
+ */
+void expire_addresses ( int sig )
+{
+    RadiusServer::expireAddresses();
+}
+
 /** Original function from the openvpn auth-pam plugin.
  * Usually we ignore signals, because our parent will
- * deal with them.
+ * deal with them. SIGHUP expires the cached server addresses.
  */
 void set_signals ( void )
 {
+    struct sigaction sa;
+
     signal ( SIGTERM, SIG_DFL );
 
     signal ( SIGINT, SIG_IGN );
-    signal ( SIGHUP, SIG_IGN );
+    memset ( &sa, 0, sizeof ( sa ) );
+    sa.sa_handler = expire_addresses;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset ( &sa.sa_mask );
+    sigaction ( SIGHUP, &sa, NULL );
     signal ( SIGUSR1, SIG_IGN );
     signal ( SIGUSR2, SIG_IGN );
     signal ( SIGPIPE, SIG_IGN );
@@ -769,12 +808,14 @@ void set_signals ( void )
  * - user->callingstationid
  * - user->untrustedport
  * - time string from ctime(...)
+ * - 16 random octets, so two sessions in the same second get different IDs
  * @param A pointer to the user for which the session ID is created.
  * @return A string with the hash.
  */
 string createSessionId ( UserPlugin * user )
 {
     unsigned char digest[16];
+    Octet random[16];
     char text[33]; 	//The digest.
     gcry_md_hd_t  context;						//the hash context
     int i;
@@ -782,19 +823,6 @@ string createSessionId ( UserPlugin * user )
     string strtime;
     ostringstream portnumber;
     memset ( digest,0,16 );
-    if (!gcry_control (GCRYCTL_ANY_INITIALIZATION_P))
-    { /* No other library has already initialized libgcrypt. */
-
-      gcry_control(GCRYCTL_SET_THREAD_CBS,&gcry_threads_pthread);
-
-      if (!gcry_check_version (NEED_LIBGCRYPT_VERSION) )
-	{
-	    cerr << "libgcrypt is too old (need " << NEED_LIBGCRYPT_VERSION << ", have " << gcry_check_version (NULL) << ")\n";
-	}
-	/* Disable secure memory.  */
-      gcry_control (GCRYCTL_DISABLE_SECMEM, 0);
-      gcry_control (GCRYCTL_INITIALIZATION_FINISHED);
-    }
     //build the hash
     gcry_md_open ( &context, GCRY_MD_MD5, 0 );
     gcry_md_write ( context, user->getCommonname().c_str(), user->getCommonname().length() );
@@ -807,6 +835,8 @@ string createSessionId ( UserPlugin * user )
     time ( &rawtime );
     strtime=ctime ( &rawtime );
     gcry_md_write ( context, strtime.c_str(),strtime.length() );
+    RadiusRandom::getBytes ( random, 16 );
+    gcry_md_write ( context, random, 16 );
     memcpy ( digest, gcry_md_read ( context, GCRY_MD_MD5 ), 16 );
     gcry_md_close ( context );
 
@@ -827,17 +857,17 @@ string createSessionId ( UserPlugin * user )
 }
 
 
-/** The function implements the thread for authentication. If the auth_control_file is specified the thread writes the results in the
+/** The function implements the thread of an authentication worker. If the auth_control_file is specified the thread writes the results in the
  * auth_control_file, if the file is not specified the thread forward the OPENVPN_PLUGIN_FUNC_SUCCESS or OPENVPN_PLUGIN_FUNC_ERROR
- * to the main process.
- * @param _context The context pointer from OpenVPN.
+ * to the main process. The workers take the users from the same list, every worker sends the users to its own background process.
+ * @param w The authentication worker.
  */
 
-void  * auth_user_pass_verify(void * c)
+void  * auth_user_pass_verify(void * w)
 {
     cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: Auth_user_pass_verify thread started."<< endl;
-    PluginContext * context = (PluginContext *) c;
-    //pthread_mutex_lock(context->getMutexSend());
+    AuthWorker * worker = (AuthWorker *) w;
+    PluginContext * context = worker->context;
     //main thread loop for authentication
 
     //ignore signals
@@ -852,26 +882,47 @@ void  * auth_user_pass_verify(void * c)
     pthread_sigmask (SIG_BLOCK, &signal_mask, NULL);
 
 
+    UserPlugin *nextuser=NULL;	/**<A user which waited for the in-flight limit of its server group.*/
+
     while (!context->getStopThread())
     {
-        pthread_mutex_lock(context->getMutexSend());
-        if (context->UserWaitingtoAuth()==false)
-        {
-            if ( DEBUG ( context->getVerbosity() ) ) cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: Waiting for new user." << endl;
-            cout.flush();
-            pthread_cond_wait(context->getCondSend(),context->getMutexSend());
-        }
-        pthread_mutex_unlock(context->getMutexSend());
+        UserPlugin	*olduser=NULL;	/**<A context for an already known user.*/
+        UserPlugin	*newuser=NULL;	/**<A context for the new user.*/
+        RadiusServerGroup *group;	/**<The server group of the user.*/
+        AccessReply	reply;			/**<The attributes of the Access-Accept.*/
+        
+        //the workers take the users without a lock, every push wakes one worker
         if (context->getStopThread()==true)
         {
             cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: Stop signal received." << endl;
             break;
         }
+        if (nextuser != NULL)
+        {
+            //the user got the login of the last user of the worker
+            newuser=nextuser;
+            nextuser=NULL;
+            group=context->radiusconf.getAuthServerGroup(newuser->getUsername());
+        }
+        else
+        {
+            newuser=context->getNewUser();
+            if (newuser == NULL)
+            {
+                if ( DEBUG ( context->getVerbosity() ) ) cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: Waiting for new user." << endl;
+                context->waitNewUser();
+                continue;
+            }
+            //a user of a realm with maxinflight waits, if the realm has too many logins
+            group=context->radiusconf.getAuthServerGroup(newuser->getUsername());
+            if (!context->startLogin(group, newuser))
+            {
+                if ( DEBUG ( context->getVerbosity() ) ) cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: User " << newuser->getUsername() << " waits for the maxinflight of the realm." << endl;
+                continue;
+            }
+        }
         if ( DEBUG ( context->getVerbosity() ) ) cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: New user from OpenVPN!" << endl;
-        //is the user already known?
-        UserPlugin	*olduser=NULL;	/**<A context for an already known user.*/
-        UserPlugin	*newuser=NULL;	/**<A context for the new user.*/
-        newuser = context->getNewUser();
+        //is the user already known? findUser() gives the worker a reference to the user
         olduser=context->findUser ( newuser->getKey() );
 
         if ( olduser!=NULL )  //probably key renegotiation
@@ -890,6 +941,7 @@ void  * auth_user_pass_verify(void * c)
             olduser->setPassword(newuser->getPassword());
             olduser->setUsername(newuser->getUsername());
             olduser->setAuthControlFile(newuser->getAuthControlFile());
+            olduser->setCompletion(newuser->getCompletion());
             //delete the newuser and use the olduser
             delete newuser;
             newuser=olduser;
@@ -899,9 +951,43 @@ void  * auth_user_pass_verify(void * c)
         {
             cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: New user." << endl;
             newuser->setPortnumber ( context->addNasPort() );
+            if ( newuser->getPortnumber() == 0 )
+            {
+                cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: No free NAS port for the user, see firstnasport and lastnasport." << endl;
+                if (newuser->getAuthControlFile().length()>0 && context->conf.getUseAuthControlFile())
+                {
+                    write_control_file(context, newuser->getAuthControlFile(), '0');
+                }
+                else
+                {
+                    newuser->complete(OPENVPN_PLUGIN_FUNC_ERROR);
+                }
+                delete newuser;
+                nextuser=context->finishLogin(group);
+                continue;
+            }
             newuser->setSessionId ( createSessionId ( newuser ) );
-            //add the user to the context
-            context->addUser(newuser);
+            //add the user to the context, another worker can have added a user with the key in the meantime
+            try
+            {
+                context->addUser(newuser);
+            }
+            catch ( Exception &e )
+            {
+                cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: User with key " << newuser->getKey() << " is already verified by another worker." << endl;
+                context->delNasPort(newuser->getPortnumber());
+                if (newuser->getAuthControlFile().length()>0 && context->conf.getUseAuthControlFile())
+                {
+                    write_control_file(context, newuser->getAuthControlFile(), '0');
+                }
+                else
+                {
+                    newuser->complete(OPENVPN_PLUGIN_FUNC_ERROR);
+                }
+                delete newuser;
+                nextuser=context->finishLogin(group);
+                continue;
+            }
         }
 
         if ( DEBUG ( context->getVerbosity() ) )
@@ -913,54 +999,35 @@ void  * auth_user_pass_verify(void * c)
         if ( newuser->getUsername().size() > 0 )  //&& olduser==NULL)
         {
             //send the informations to the background process
-            context->authsocketbackgr.send ( COMMAND_VERIFY );
-            context->authsocketbackgr.send ( newuser->getUsername() );
-            context->authsocketbackgr.send ( newuser->getPassword() );
-            context->authsocketbackgr.send ( newuser->getDev() );
-            context->authsocketbackgr.send ( newuser->getPortnumber() );
-            context->authsocketbackgr.send ( newuser->getSessionId() );
-            context->authsocketbackgr.send ( newuser->getCallingStationId() );
-            context->authsocketbackgr.send ( newuser->getCommonname() );
-            context->authsocketbackgr.send ( newuser->getFramedIp() );
+            worker->socket.send ( COMMAND_VERIFY );
+            worker->socket.send ( newuser->getUsername() );
+            worker->socket.send ( newuser->getPassword() );
+            worker->socket.send ( newuser->getDev() );
+            worker->socket.send ( newuser->getPortnumber() );
+            worker->socket.send ( newuser->getSessionId() );
+            worker->socket.send ( newuser->getCallingStationId() );
+            worker->socket.send ( newuser->getCommonname() );
+            worker->socket.send ( newuser->getFramedIp() );
 
             //get the response
-            const int status = context->authsocketbackgr.recvInt();
+            const int status = worker->socket.recvInt();
             if ( status == RESPONSE_SUCCEEDED )
             {
                 if ( DEBUG ( context->getVerbosity() ) )
                     cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: Authentication succeeded!" << endl;
 
-                //get the routes from background process
-                newuser->setFramedRoutes ( context->authsocketbackgr.recvStr() );
+                //get the attributes of the Access-Accept from the background process
+                worker->socket.recvReply ( &reply );
+                reply.apply ( newuser );
                 if ( DEBUG ( context->getVerbosity() ) )
+                {
                     cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: Received routes for user: "<< newuser->getFramedRoutes() << "." << endl;
-                //get the framed ip
-                newuser->setFramedIp ( context->authsocketbackgr.recvStr() );
-                if ( DEBUG ( context->getVerbosity() ) )
                     cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: Received framed ip for user: "<< newuser->getFramedIp() << "." << endl;
-                //get the routes from background process
-                newuser->setFramedRoutes6 ( context->authsocketbackgr.recvStr() );
-                if ( DEBUG ( context->getVerbosity() ) )
                     cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: Received IPv6 routes for user: "<< newuser->getFramedRoutes6() << ".\n";
-                //get the framed IPv6
-                newuser->setFramedIp6 ( context->authsocketbackgr.recvStr() );
-                if ( DEBUG ( context->getVerbosity() ) )
                     cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: Received framed IPv6 for user: "<< newuser->getFramedIp6() << "." << endl;
-
-
-                // get the interval from the background process
-                newuser->setAcctInterimInterval ( context->authsocketbackgr.recvInt() );
-                if ( DEBUG ( context->getVerbosity() ) )
                     cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: Receive acctinteriminterval " << newuser->getAcctInterimInterval() <<" sec from backgroundprocess." << endl;
-
-                //clear the buffer if it isn't empty
-                if ( newuser->getVsaBuf() !=NULL )
-                {
-                    delete [] newuser->getVsaBuf();
-                    newuser->setVsaBuf ( NULL );
+                    cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: Received " << reply.vsas.size() << " vendor specific attributes." << endl;
                 }
-                // get the vendor specific attribute buffer from the background process
-                context->authsocketbackgr.recvBuf ( newuser );
 
                 //add the user to the context
                 // if the is already in the map, addUser will throw an exception
@@ -983,11 +1050,7 @@ void  * auth_user_pass_verify(void * c)
                 }
                 else
                 {
-                    pthread_mutex_lock(context->getMutexRecv());
-                    context->setResult(OPENVPN_PLUGIN_FUNC_SUCCESS);
-                    
-                    pthread_cond_signal( context->getCondRecv( ));
-                    pthread_mutex_unlock (context->getMutexRecv());
+                    newuser->complete(OPENVPN_PLUGIN_FUNC_SUCCESS);
 
                 }
 
@@ -1025,16 +1088,12 @@ void  * auth_user_pass_verify(void * c)
                 }
                 else
                 {
-                    pthread_mutex_lock(context->getMutexRecv());
-                    context->setResult(OPENVPN_PLUGIN_FUNC_ERROR);
-                    pthread_cond_signal( context->getCondRecv( ));
-                    pthread_mutex_unlock (context->getMutexRecv());
+                    newuser->complete(OPENVPN_PLUGIN_FUNC_ERROR);
                 }
                 //clean up: nas port, context, memory
 		if ( ! newuser->isAccounted() ){
 			context->delNasPort(newuser->getPortnumber());
 			context->delUser(newuser->getKey());
-			delete newuser;
 		}
             }
         }
@@ -1051,16 +1110,15 @@ void  * auth_user_pass_verify(void * c)
             }
             else
             {
-                pthread_mutex_lock(context->getMutexRecv());
-                context->setResult(OPENVPN_PLUGIN_FUNC_ERROR);
-                
-                pthread_cond_signal( context->getCondRecv( ));
-		pthread_mutex_unlock (context->getMutexRecv());
+                newuser->complete(OPENVPN_PLUGIN_FUNC_ERROR);
             }
-            delete newuser;
         }
+        //drop the reference of the worker, the user stays in the map if it was not deleted
+        newuser->release();
+        nextuser=context->finishLogin(group);
     }
-    pthread_mutex_unlock(context->getMutexSend());
+    //a user which got a login is freed like the users which still wait
+    delete nextuser;
     cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: Thread finished.\n";
     pthread_exit(NULL);
 }
@@ -1075,7 +1133,6 @@ void  * client_connect(void * c)
     cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: client_connect thread started."<< endl;
     //PluginContext * context = (PluginContext *) c;
     PluginContext * context = (PluginContext *) c;
-    //pthread_mutex_lock(context->getMutexSend());
     //main thread loop for authentication
 
     //ignore signals
@@ -1091,26 +1148,25 @@ void  * client_connect(void * c)
     
     while (!context->getStopThread())
     {
-        pthread_mutex_lock(context->getAcctMutexSend());
-        if (context->UserWaitingtoAcct()==false)
-            {
-                if ( DEBUG ( context->getVerbosity() ) ) cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: Waiting for new accounting user." << endl;
-                cout.flush();
-                pthread_cond_wait(context->getAcctCondSend(),context->getAcctMutexSend());
-            }
-            pthread_mutex_unlock(context->getAcctMutexSend());
+            UserPlugin	*newuser=NULL;	/**<A context for an already known user.*/
+            UserPlugin	*tmpuser=NULL;	/**<A context for the new user.*/
+            
+            //the queue is drained before the thread waits again, one wakeup can stand for a batch of users
             if (context->getStopThread()==true)
             {
                 cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: Stop signal received." << endl;
                 break;
             }
+            tmpuser=context->getNewAcctUser();
+            if (tmpuser == NULL)
+            {
+                if ( DEBUG ( context->getVerbosity() ) ) cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: Waiting for new accounting user." << endl;
+                context->waitNewAcctUser();
+                continue;
+            }
     
             //find the user in the context, he was added at the OPENVPN_PLUGIN_AUTH_USER_PASS_VERIFY
             //string key=common_name + string ( "," ) +untrusted_ip+string ( ":" ) + string ( get_env ( "untrusted_port", envp ) );
-            
-            UserPlugin	*newuser=NULL;	/**<A context for an already known user.*/
-            UserPlugin	*tmpuser=NULL;	/**<A context for the new user.*/
-            tmpuser=context->getNewAcctUser();
             newuser=context->findUser(tmpuser->getKey());
             if (newuser == NULL)
             {
@@ -1119,6 +1175,17 @@ void  * client_connect(void * c)
                     newuser=tmpuser;
                     newuser->setAuthenticated(true); //the plugin does not care about it
                     newuser->setPortnumber ( context->addNasPort() );
+                    if ( newuser->getPortnumber() == 0 )
+                    {
+                        cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: No free NAS port for the user, see firstnasport and lastnasport.\n";
+                        if (tmpuser->getClientConnectDeferFile().length()>0 && context->conf.getUseClientConnectDeferFile())
+                        {
+                            write_control_file(context, tmpuser->getClientConnectDeferFile(), '0');
+                        }
+                        tmpuser->complete(OPENVPN_PLUGIN_FUNC_ERROR);
+                        delete tmpuser;
+                        continue;
+                    }
                     newuser->setSessionId ( createSessionId ( newuser ) );
                     if (!newuser->getAcctInterimInterval())
                         newuser->setAcctInterimInterval(context->conf.getDefAcctInterimInterval());
@@ -1128,11 +1195,13 @@ void  * client_connect(void * c)
                 else
                 {
                     cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: User should be accounted but is unknown, should only occur if accountingonly=true.\n";
-                    pthread_mutex_lock(context->getAcctMutexRecv());
-                    context->setResult(OPENVPN_PLUGIN_FUNC_ERROR);
-                    
-                    pthread_cond_signal( context->getAcctCondRecv( ));
-                    pthread_mutex_unlock (context->getAcctMutexRecv());
+                    if (tmpuser->getClientConnectDeferFile().length()>0 && context->conf.getUseClientConnectDeferFile())
+                    {
+                        write_control_file(context, tmpuser->getClientConnectDeferFile(), '0');
+                    }
+                    tmpuser->complete(OPENVPN_PLUGIN_FUNC_ERROR);
+                    delete tmpuser;
+                    continue;
                 }
             }
             else
@@ -1142,6 +1211,7 @@ void  * client_connect(void * c)
                 newuser->setFramedRoutes(tmpuser->getFramedRoutes());
                 newuser->setFramedRoutes6(tmpuser->getFramedRoutes6());
                 newuser->setClientConnectDeferFile(tmpuser->getClientConnectDeferFile());
+                newuser->setCompletion(tmpuser->getCompletion());
 
                 delete(tmpuser);
             }
@@ -1190,11 +1260,7 @@ void  * client_connect(void * c)
                     }
                     else
                     {
-                        pthread_mutex_lock(context->getAcctMutexRecv());
-                        context->setResult(OPENVPN_PLUGIN_FUNC_SUCCESS);
-                        
-                        pthread_cond_signal( context->getAcctCondRecv( ));
-                        pthread_mutex_unlock (context->getAcctMutexRecv());
+                        newuser->complete(OPENVPN_PLUGIN_FUNC_SUCCESS);
 
                     }
 
@@ -1217,26 +1283,23 @@ void  * client_connect(void * c)
                         write_control_file(context, newuser->getClientConnectDeferFile(), '0');
 
                     }
-                    pthread_mutex_lock(context->getAcctMutexRecv());
-                    context->setResult(OPENVPN_PLUGIN_FUNC_ERROR);
-                    pthread_cond_signal( context->getAcctCondRecv( ));
-                    pthread_mutex_unlock (context->getAcctMutexRecv());
+                    newuser->complete(OPENVPN_PLUGIN_FUNC_ERROR);
 
                 }
             }
             else
             {
                 cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: No user with this commonname or he is already authenticated\n";
-                pthread_mutex_lock(context->getAcctMutexRecv());
-                context->setResult(OPENVPN_PLUGIN_FUNC_ERROR);
-
-                pthread_cond_signal( context->getAcctCondRecv( ));
-                pthread_mutex_unlock (context->getAcctMutexRecv());
+                if (newuser->getClientConnectDeferFile().length()>0 && context->conf.getUseClientConnectDeferFile())
+                {
+                    write_control_file(context, newuser->getClientConnectDeferFile(), '0');
+                }
+                newuser->complete(OPENVPN_PLUGIN_FUNC_ERROR);
 
             }
+            //drop the reference of the thread, the user stays in the map if it was not deleted
+            newuser->release();
     }
-    pthread_mutex_unlock(context->getAcctMutexRecv());
-    pthread_mutex_unlock(context->getAcctMutexSend());
     cerr << getTime() << "RADIUS-PLUGIN: FOREGROUND THREAD: Thread finished.\n";
     pthread_exit(NULL);
 
@@ -105,6 +105,7 @@ struct name_value_list {
 const char * get_env (const char *name, const char *envp[]);
 int string_array_len (const char *array[]);
 void close_fds_except (int keep);
+void expire_addresses (int);
 void set_signals (void);
 string createSessionId (UserPlugin *);
 void get_user_env(PluginContext *, const int type,const char *envp[], UserPlugin *);